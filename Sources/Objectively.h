@@ -29,6 +29,7 @@
  */
 
 #include <Objectively/Array.h>
+#include <Objectively/AutoreleasePool.h>
 #include <Objectively/Boole.h>
 #include <Objectively/Class.h>
 #include <Objectively/Condition.h>
@@ -43,6 +44,7 @@
 #include <Objectively/HashTable.h>
 #include <Objectively/IndexPath.h>
 #include <Objectively/IndexSet.h>
+#include <Objectively/Instrumentation.h>
 #include <Objectively/JSONPath.h>
 #include <Objectively/JSONContext.h>
 #include <Objectively/JSONSerializers.h>
@@ -62,7 +64,10 @@
 #include <Objectively/RESTClient.h>
 #include <Objectively/Resource.h>
 #include <Objectively/Set.h>
+#include <Objectively/Slab.h>
+#include <Objectively/Slice.h>
 #include <Objectively/String.h>
+#include <Objectively/StringBuilder.h>
 #include <Objectively/StringReader.h>
 #include <Objectively/Thread.h>
 #include <Objectively/Types.h>
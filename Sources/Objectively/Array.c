@@ -26,10 +26,13 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "Array.h"
 #include "Hash.h"
+#include "OperationQueue.h"
 #include "String.h"
+#include "StringBuilder.h"
 
 #if defined(__APPLE__)
 
@@ -74,7 +77,113 @@ void quicksort(ident base, size_t count, size_t size, Comparator comparator, ide
 
 #define _Class _Array
 
-#define ARRAY_CHUNK_SIZE 64
+/**
+ * @brief The capacity of an Array's first allocation. Each after it doubles.
+ */
+#define ARRAY_MIN_CAPACITY 16
+
+/**
+ * @brief Shares the elements of `array` with `self`, which must have none of its own.
+ */
+static void share(Array *self, const Array *array) {
+
+  if (array->count == 0) {
+    return;
+  }
+
+  /* Copying is not a mutation, so two threads may copy the same Array at once. */
+  size_t *references = __atomic_load_n(&((Array *) array)->references, __ATOMIC_ACQUIRE);
+  if (references == NULL) {
+
+    size_t *owner = malloc(sizeof(size_t));
+    assert(owner);
+
+    *owner = 1;
+
+    if (__atomic_compare_exchange_n(&((Array *) array)->references, &references, owner, 0,
+        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      references = owner;
+    } else {
+      free(owner);
+    }
+  }
+
+  __atomic_add_fetch(references, 1, __ATOMIC_RELAXED);
+
+  self->elements = array->elements;
+  self->count = array->count;
+  self->capacity = array->capacity;
+  self->references = references;
+}
+
+/**
+ * @brief Relinquishes this Array's elements, releasing them if no other Array shares them.
+ */
+static void relinquish(Array *self) {
+
+  if (self->references == NULL || __atomic_sub_fetch(self->references, 1, __ATOMIC_ACQ_REL) == 0) {
+
+    for (size_t i = 0; i < self->count; i++) {
+      release(self->elements[i]);
+    }
+
+    free(self->elements);
+    free(self->references);
+  }
+
+  self->elements = NULL;
+  self->references = NULL;
+}
+
+/**
+ * @brief Ensures that this Array owns its elements outright, before it is mutated.
+ */
+static void unshare(Array *self) {
+
+  size_t *references = self->references;
+  if (references) {
+
+    if (__atomic_load_n(references, __ATOMIC_ACQUIRE) > 1) {
+
+      ident *elements = malloc(self->capacity * sizeof(ident));
+      assert(elements);
+
+      for (size_t i = 0; i < self->count; i++) {
+        elements[i] = retain(self->elements[i]);
+      }
+
+      /* Every other Array may have let go while these were retained. */
+      relinquish(self);
+
+      self->elements = elements;
+    } else {
+      free(references);
+      self->references = NULL;
+    }
+  }
+}
+
+/**
+ * @brief Ensures that this Array owns its elements, and has room for `count` of them.
+ * @details Capacity grows geometrically, so that repeated additions are amortized.
+ */
+static void grow(Array *self, size_t count) {
+
+  unshare(self);
+
+  if (count > self->capacity) {
+
+    size_t capacity = self->capacity << 1;
+    if (capacity < ARRAY_MIN_CAPACITY) {
+      capacity = ARRAY_MIN_CAPACITY;
+    }
+    if (capacity < count) {
+      capacity = count;
+    }
+
+    $(self, reserveCapacity, capacity);
+  }
+}
 
 #pragma mark - Object
 
@@ -85,10 +194,10 @@ static Object *copy(const Object *self) {
 
   const Array *this = (Array *) self;
 
-  Array *copy = $(alloc(Array), initWithCapacity, this->count);
+  Array *copy = $(alloc(Array), init);
   assert(copy);
 
-  $(copy, addObjectsFromArray, this);
+  share(copy, this);
 
   return (Object *) copy;
 }
@@ -98,15 +207,24 @@ static Object *copy(const Object *self) {
  */
 static void dealloc(Object *self) {
 
-  Array *this = (Array *) self;
+  relinquish((Array *) self);
 
-  for (size_t i = 0; i < this->count; i++) {
-    release(this->elements[i]);
-  }
+  super(Object, self, dealloc);
+}
 
-  free(this->elements);
+/**
+ * @brief Appends the descriptions of the elements of `self`, separated by `chars`, to `builder`.
+ */
+static void appendComponents(const Array *self, StringBuilder *builder, const char *chars) {
 
-  super(Object, self, dealloc);
+  for (size_t i = 0; i < self->count; i++) {
+
+    if (i) {
+      $(builder, appendCharacters, chars);
+    }
+
+    $(builder, appendDescription, self->elements[i]);
+  }
 }
 
 /**
@@ -114,11 +232,15 @@ static void dealloc(Object *self) {
  */
 static String *description(const Object *self) {
 
-  String *components = $((Array *) self, componentsJoinedByCharacters, ", ");
+  StringBuilder *builder = $(alloc(StringBuilder), init);
+
+  $(builder, appendCharacters, "[");
+  appendComponents((Array *) self, builder, ", ");
+  $(builder, appendCharacters, "]");
 
-  String *desc = $(alloc(String), initWithFormat, "[%s]", components->chars ?: "");
+  String *desc = $(builder, string);
 
-  release(components);
+  release(builder);
 
   return desc;
 }
@@ -130,13 +252,15 @@ static int hash(const Object *self) {
 
   Array *this = (Array *) self;
 
-  int hash = HashForInteger(HASH_SEED, this->count);
+  const uint64_t seed = Hash64Seed();
+
+  uint64_t hash = Hash64ForInteger(seed, this->count);
 
   for (size_t i = 0; i < this->count; i++) {
-    hash = HashForObject(hash, this->elements[i]);
+    hash = Hash64Combine(hash, Hash64ForObject(seed, this->elements[i]));
   }
 
-  return hash;
+  return (int) hash;
 }
 
 /**
@@ -180,18 +304,7 @@ static bool isEqual(const Object *self, const Object *other) {
  */
 static void addObject(Array *self, const ident obj) {
 
-  if (self->count == self->capacity) {
-
-    self->capacity += ARRAY_CHUNK_SIZE;
-
-    if (self->elements) {
-      self->elements = realloc(self->elements, self->capacity * sizeof(ident));
-    } else {
-      self->elements = calloc(self->capacity, sizeof(ident));
-    }
-
-    assert(self->elements);
-  }
+  grow(self, self->count + 1);
 
   self->elements[self->count++] = retain(obj);
 }
@@ -221,8 +334,32 @@ static void addObjects(Array *self, const ident obj, ...) {
 static void addObjectsFromArray(Array *self, const Array *array) {
 
   if (array) {
-    for (size_t i = 0; i < array->count; i++) {
-      $(self, addObject, array->elements[i]);
+    $(self, addObjectsWithCount, array->count, array->elements);
+  }
+}
+
+/**
+ * @fn void Array::addObjectsWithCount(Array *self, size_t count, const ident *objects)
+ * @memberof Array
+ */
+static void addObjectsWithCount(Array *self, size_t count, const ident *objects) {
+
+  if (count) {
+    assert(objects);
+
+    // objects may alias our own elements, which grow may reallocate
+
+    const uintptr_t elements = (uintptr_t) self->elements;
+    const uintptr_t offset = (uintptr_t) objects - elements;
+
+    grow(self, self->count + count);
+
+    if (offset < self->count * sizeof(ident)) {
+      objects = self->elements + offset / sizeof(ident);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+      self->elements[self->count++] = retain(objects[i]);
     }
   }
 }
@@ -260,22 +397,25 @@ static Array *arrayWithCapacity(size_t capacity) {
  */
 static Array *arrayWithObjects(ident obj, ...) {
 
-  Array *array = (Array *) super(Object, alloc(Array), init);
-  if (array) {
-    va_list args;
-    va_start(args, obj);
+  va_list args, count;
+  va_start(args, obj);
 
-    while (obj) {
-      array->elements = realloc(array->elements, ++array->count * sizeof(ident));
-      assert(array->elements);
+  va_copy(count, args);
+  size_t capacity = 0;
+  for (ident object = obj; object; object = va_arg(count, ident)) {
+    capacity++;
+  }
+  va_end(count);
 
-      array->elements[array->count - 1] = retain(obj);
-      obj = va_arg(args, ident);
+  Array *array = $(alloc(Array), initWithCapacity, capacity);
+  if (array) {
+    for (ident object = obj; object; object = va_arg(args, ident)) {
+      array->elements[array->count++] = retain(object);
     }
-
-    va_end(args);
   }
 
+  va_end(args);
+
   return array;
 }
 
@@ -294,21 +434,15 @@ static Array *arrayWithVaList(va_list args) {
  */
 static String *componentsJoinedByCharacters(const Array *self, const char *chars) {
 
-  String *string = $(alloc(String), init);
+  StringBuilder *builder = $(alloc(StringBuilder), init);
 
-  for (size_t i = 0; i < self->count; i++) {
+  appendComponents(self, builder, chars);
 
-    String *desc = $((Object *) self->elements[i], description);
-    $(string, appendString, desc);
+  String *string = $(builder, string);
 
-    release(desc);
+  release(builder);
 
-    if (i < self->count - 1) {
-      $(string, appendCharacters, chars);
-    }
-  }
-
-  return (String *) string;
+  return string;
 }
 
 /**
@@ -348,11 +482,18 @@ static void filter(Array *self, Predicate predicate, ident data) {
 
   assert(predicate);
 
+  unshare(self);
+
+  size_t count = 0;
   for (size_t i = 0; i < self->count; i++) {
-    if (predicate(self->elements[i], data) == false) {
-      $(self, removeObjectAtIndex, i--);
+    if (predicate(self->elements[i], data)) {
+      self->elements[count++] = self->elements[i];
+    } else {
+      release(self->elements[i]);
     }
   }
+
+  self->count = count;
 }
 
 /**
@@ -430,17 +571,7 @@ static Array *initWithArray(Array *self, const Array *array) {
 
   self = (Array *) super(Object, self, init);
   if (self) {
-
-    self->count = array->count;
-    if (self->count) {
-
-      self->elements = calloc(self->count, sizeof(ident));
-      assert(self->elements);
-
-      for (size_t i = 0; i < self->count; i++) {
-        self->elements[i] = retain(array->elements[i]);
-      }
-    }
+    share(self, array);
   }
 
   return self;
@@ -487,16 +618,20 @@ static Array *initWithObjects(Array *self, ...) {
  */
 static Array *initWithVaList(Array *self, va_list args) {
 
-  self = (Array *) super(Object, self, init);
-  if (self) {
+  va_list count;
+  va_copy(count, args);
 
-    ident element = va_arg(args, ident);
-    while (element) {
-      self->elements = realloc(self->elements, ++self->count * sizeof(ident));
-      assert(self->elements);
+  size_t capacity = 0;
+  while (va_arg(count, ident)) {
+    capacity++;
+  }
+
+  va_end(count);
 
-      self->elements[self->count - 1] = retain(element);
-      element = va_arg(args, ident);
+  self = $(self, initWithCapacity, capacity);
+  if (self) {
+    for (ident object = va_arg(args, ident); object; object = va_arg(args, ident)) {
+      self->elements[self->count++] = retain(object);
     }
   }
 
@@ -511,13 +646,44 @@ static void insertObjectAtIndex(Array *self, ident obj, size_t index) {
 
   assert(index <= self->count);
 
-  $(self, addObject, obj);
+  grow(self, self->count + 1);
+
+  memmove(self->elements + index + 1, self->elements + index, (self->count - index) * sizeof(ident));
+
+  self->elements[index] = retain(obj);
+  self->count++;
+}
+
+/**
+ * @fn void Array::insertObjectsAtIndexes(Array *self, const ident *objects, const IndexSet *indexes)
+ * @memberof Array
+ */
+static void insertObjectsAtIndexes(Array *self, const ident *objects, const IndexSet *indexes) {
+
+  assert(indexes);
 
-  for (size_t i = self->count - 1; i > index; i--) {
-    self->elements[i] = self->elements[i - 1];
+  if (indexes->count == 0) {
+    return;
   }
 
-  self->elements[index] = obj;
+  assert(objects);
+
+  const size_t count = self->count + indexes->count;
+  assert(indexes->indexes[indexes->count - 1] < count);
+
+  grow(self, count);
+
+  size_t i = self->count, j = indexes->count, k = count;
+  while (j) {
+    k--;
+    if (indexes->indexes[j - 1] == k) {
+      self->elements[k] = retain(objects[--j]);
+    } else {
+      self->elements[k] = self->elements[--i];
+    }
+  }
+
+  self->count = count;
 }
 
 /**
@@ -537,6 +703,8 @@ static void map(Array *self, Functor functor, ident data) {
 
   assert(functor);
 
+  unshare(self);
+
   for (size_t i = 0; i < self->count; i++) {
     ident obj = functor(self->elements[i], data);
 
@@ -582,6 +750,492 @@ static ident objectAtIndex(const Array *self, size_t index) {
   return self->elements[index];
 }
 
+/**
+ * @brief Runs shorter than this are insertion sorted before they are merged.
+ */
+#define ARRAY_SORT_RUN 16
+
+/**
+ * @brief The cache line size, on which the `parallel` methods split the spans they write.
+ */
+#define ARRAY_CACHE_LINE 64
+
+/**
+ * @brief Arrays are split into chunks of at least this many elements for the `parallel` methods.
+ */
+#define ARRAY_PARALLEL_CHUNK 0x400
+
+/**
+ * @brief Arrays are split into chunks of at least this many elements for `parallelSort`.
+ */
+#define ARRAY_PARALLEL_SORT_CHUNK 0x8000
+
+/**
+ * @brief The most chunks the `parallel` methods will split an Array into.
+ */
+#define ARRAY_PARALLEL_CHUNKS 64
+
+/**
+ * @brief Stably merges the sorted runs `in[lo, mid)` and `in[mid, hi)` into `out[lo, hi)`.
+ */
+static void mergeRuns(const ident *in, ident *out, size_t lo, size_t mid, size_t hi, Comparator comparator) {
+
+  if (mid == lo || mid == hi || comparator(in[mid - 1], in[mid]) <= OrderSame) {
+    memcpy(out + lo, in + lo, (hi - lo) * sizeof(ident));
+    return;
+  }
+
+  size_t i = lo, j = mid, k = lo;
+  while (i < mid && j < hi) {
+    if (comparator(in[i], in[j]) > OrderSame) {
+      out[k++] = in[j++];
+    } else {
+      out[k++] = in[i++];
+    }
+  }
+
+  memcpy(out + k, in + i, (mid - i) * sizeof(ident));
+  memcpy(out + k + (mid - i), in + j, (hi - j) * sizeof(ident));
+}
+
+/**
+ * @brief Stably sorts `elements` with a bottom-up merge sort.
+ * @param elements The elements to sort.
+ * @param buffer Scratch space for as many elements.
+ * @param count The count of elements.
+ * @param comparator The Comparator.
+ */
+static void mergeSort(ident *elements, ident *buffer, size_t count, Comparator comparator) {
+
+  for (size_t lo = 0; lo < count; lo += ARRAY_SORT_RUN) {
+    const size_t hi = min(lo + ARRAY_SORT_RUN, count);
+
+    for (size_t i = lo + 1; i < hi; i++) {
+      ident element = elements[i];
+
+      size_t j = i;
+      for (; j > lo && comparator(elements[j - 1], element) > OrderSame; j--) {
+        elements[j] = elements[j - 1];
+      }
+
+      elements[j] = element;
+    }
+  }
+
+  ident *in = elements, *out = buffer;
+
+  for (size_t width = ARRAY_SORT_RUN; width < count; width <<= 1) {
+    for (size_t lo = 0; lo < count; lo += width << 1) {
+      mergeRuns(in, out, lo, min(lo + width, count), min(lo + (width << 1), count), comparator);
+    }
+
+    ident *swap = in;
+    in = out;
+    out = swap;
+  }
+
+  if (in != elements) {
+    memcpy(elements, in, count * sizeof(ident));
+  }
+}
+
+/**
+ * @brief A contiguous span of an Array, processed by one Operation of a `parallel` method.
+ * @details Tasks are written by different threads, and so are padded to a cache line apiece.
+ */
+typedef struct {
+  ident *in, *out;
+  size_t lo, mid, hi;
+  union {
+    Comparator comparator;
+    Functor functor;
+    Predicate predicate;
+    Reducer reducer;
+  };
+  ident data;
+  ident accumulator;
+  size_t count;
+} __attribute__((aligned(ARRAY_CACHE_LINE))) ParallelTask;
+
+/**
+ * @brief Splits `count` elements into chunks of at least `size` elements.
+ * @param out The elements to be written, or `NULL`. Chunks are split on cache lines of `out`, so
+ * that no two chunks write the same line.
+ * @param count The count of elements.
+ * @param size The least number of elements per chunk.
+ * @param bounds Receives the bounds of each chunk, which spans `bounds[i]` to `bounds[i + 1]`.
+ * @return The number of chunks.
+ */
+static size_t chunk(const ident *out, size_t count, size_t size, size_t *bounds) {
+
+  const size_t chunks = clamp(count / size, (size_t) 1, (size_t) ARRAY_PARALLEL_CHUNKS);
+
+  bounds[0] = 0;
+
+  for (size_t i = 1; i < chunks; i++) {
+    size_t bound = i * count / chunks;
+    if (out) {
+      const uintptr_t line = (uintptr_t) (out + bound) & ~((uintptr_t) ARRAY_CACHE_LINE - 1);
+      bound = (line - (uintptr_t) out) / sizeof(ident);
+    }
+    bounds[i] = max(bound, bounds[i - 1]);
+  }
+
+  bounds[chunks] = count;
+
+  return chunks;
+}
+
+/**
+ * @brief Runs `count` tasks with `function`, all but the last on `queue`, and the last on the
+ * calling thread, and then waits for them all to finish.
+ * @param queue The OperationQueue, or `NULL` for the shared queue.
+ */
+static void dispatch(OperationQueue *queue, OperationFunction function, ParallelTask *tasks, size_t count) {
+
+  Operation *operations[ARRAY_PARALLEL_CHUNKS];
+
+  if (count > 1) {
+    if (queue == NULL) {
+      queue = $$(OperationQueue, sharedQueue);
+    }
+
+    assert(queue != $$(OperationQueue, currentQueue));
+
+    for (size_t i = 0; i < count - 1; i++) {
+      operations[i] = $(queue, addOperationWithFunction, function, tasks + i);
+    }
+  }
+
+  Operation *operation = $(alloc(Operation), initWithFunction, function, tasks + count - 1);
+  $(operation, start);
+  release(operation);
+
+  for (size_t i = 0; i < count - 1; i++) {
+    $(operations[i], waitUntilFinished);
+    release(operations[i]);
+  }
+}
+
+/**
+ * @brief OperationFunction for `parallelFilteredArray`.
+ */
+static void parallelFilteredArray_filter(Operation *operation) {
+
+  ParallelTask *task = operation->data;
+
+  size_t count = 0;
+  for (size_t i = task->lo; i < task->hi; i++) {
+    if (task->predicate(task->in[i], task->data)) {
+      task->out[task->lo + count++] = retain(task->in[i]);
+    }
+  }
+
+  task->count = count;
+}
+
+/**
+ * @fn Array *Array::parallelFilteredArray(const Array *self, Predicate predicate, ident data, OperationQueue *queue)
+ * @memberof Array
+ */
+static Array *parallelFilteredArray(const Array *self, Predicate predicate, ident data, OperationQueue *queue) {
+
+  assert(predicate);
+
+  Array *array = $(alloc(Array), initWithCapacity, self->count);
+  assert(array);
+
+  ParallelTask tasks[ARRAY_PARALLEL_CHUNKS];
+  size_t bounds[ARRAY_PARALLEL_CHUNKS + 1];
+
+  const size_t chunks = chunk(array->elements, self->count, ARRAY_PARALLEL_CHUNK, bounds);
+
+  for (size_t i = 0; i < chunks; i++) {
+    tasks[i] = (ParallelTask) {
+      .in = self->elements,
+      .out = array->elements,
+      .lo = bounds[i],
+      .hi = bounds[i + 1],
+      .predicate = predicate,
+      .data = data
+    };
+  }
+
+  dispatch(queue, parallelFilteredArray_filter, tasks, chunks);
+
+  for (size_t i = 0; i < chunks; i++) {
+    if (tasks[i].count && tasks[i].lo > array->count) {
+      memmove(array->elements + array->count, array->elements + tasks[i].lo, tasks[i].count * sizeof(ident));
+    }
+    array->count += tasks[i].count;
+  }
+
+  return array;
+}
+
+/**
+ * @brief OperationFunction for `parallelMap`.
+ */
+static void parallelMap_map(Operation *operation) {
+
+  const ParallelTask *task = operation->data;
+
+  for (size_t i = task->lo; i < task->hi; i++) {
+    ident obj = task->functor(task->out[i], task->data);
+
+    retain(obj);
+
+    release(task->out[i]);
+
+    task->out[i] = obj;
+  }
+}
+
+/**
+ * @fn void Array::parallelMap(Array *self, Functor functor, ident data, OperationQueue *queue)
+ * @memberof Array
+ */
+static void parallelMap(Array *self, Functor functor, ident data, OperationQueue *queue) {
+
+  assert(functor);
+
+  unshare(self);
+
+  ParallelTask tasks[ARRAY_PARALLEL_CHUNKS];
+  size_t bounds[ARRAY_PARALLEL_CHUNKS + 1];
+
+  const size_t chunks = chunk(self->elements, self->count, ARRAY_PARALLEL_CHUNK, bounds);
+
+  for (size_t i = 0; i < chunks; i++) {
+    tasks[i] = (ParallelTask) {
+      .out = self->elements,
+      .lo = bounds[i],
+      .hi = bounds[i + 1],
+      .functor = functor,
+      .data = data
+    };
+  }
+
+  dispatch(queue, parallelMap_map, tasks, chunks);
+}
+
+/**
+ * @brief OperationFunction for `parallelMappedArray`.
+ */
+static void parallelMappedArray_map(Operation *operation) {
+
+  const ParallelTask *task = operation->data;
+
+  for (size_t i = task->lo; i < task->hi; i++) {
+    task->out[i] = task->functor(task->in[i], task->data);
+    assert(task->out[i]);
+  }
+}
+
+/**
+ * @fn Array *Array::parallelMappedArray(const Array *self, Functor functor, ident data, OperationQueue *queue)
+ * @memberof Array
+ */
+static Array *parallelMappedArray(const Array *self, Functor functor, ident data, OperationQueue *queue) {
+
+  assert(functor);
+
+  Array *array = $(alloc(Array), initWithCapacity, self->count);
+  assert(array);
+
+  ParallelTask tasks[ARRAY_PARALLEL_CHUNKS];
+  size_t bounds[ARRAY_PARALLEL_CHUNKS + 1];
+
+  const size_t chunks = chunk(array->elements, self->count, ARRAY_PARALLEL_CHUNK, bounds);
+
+  for (size_t i = 0; i < chunks; i++) {
+    tasks[i] = (ParallelTask) {
+      .in = self->elements,
+      .out = array->elements,
+      .lo = bounds[i],
+      .hi = bounds[i + 1],
+      .functor = functor,
+      .data = data
+    };
+  }
+
+  dispatch(queue, parallelMappedArray_map, tasks, chunks);
+
+  array->count = self->count;
+
+  return array;
+}
+
+/**
+ * @brief OperationFunction for `parallelReduce`.
+ */
+static void parallelReduce_reduce(Operation *operation) {
+
+  ParallelTask *task = operation->data;
+
+  ident accumulator = task->accumulator;
+
+  for (size_t i = task->lo; i < task->hi; i++) {
+    accumulator = task->reducer(task->in[i], accumulator, task->data);
+  }
+
+  task->accumulator = accumulator;
+}
+
+/**
+ * @fn ident Array::parallelReduce(const Array *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue)
+ * @memberof Array
+ */
+static ident parallelReduce(const Array *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue) {
+
+  assert(reducer);
+  assert(combiner);
+
+  ParallelTask tasks[ARRAY_PARALLEL_CHUNKS];
+  size_t bounds[ARRAY_PARALLEL_CHUNKS + 1];
+
+  const size_t chunks = chunk(NULL, self->count, ARRAY_PARALLEL_CHUNK, bounds);
+
+  for (size_t i = 0; i < chunks; i++) {
+    tasks[i] = (ParallelTask) {
+      .in = self->elements,
+      .lo = bounds[i],
+      .hi = bounds[i + 1],
+      .reducer = reducer,
+      .data = data,
+      .accumulator = accumulator
+    };
+  }
+
+  dispatch(queue, parallelReduce_reduce, tasks, chunks);
+
+  accumulator = tasks[0].accumulator;
+
+  for (size_t i = 1; i < chunks; i++) {
+    accumulator = combiner(tasks[i].accumulator, accumulator, data);
+  }
+
+  return accumulator;
+}
+
+/**
+ * @brief OperationFunction for sorting one chunk in `parallelSort`.
+ */
+static void parallelSort_sort(Operation *operation) {
+
+  const ParallelTask *task = operation->data;
+
+  mergeSort(task->in + task->lo, task->out + task->lo, task->hi - task->lo, task->comparator);
+}
+
+/**
+ * @brief OperationFunction for merging two adjacent chunks in `parallelSort`.
+ */
+static void parallelSort_merge(Operation *operation) {
+
+  const ParallelTask *task = operation->data;
+
+  mergeRuns(task->in, task->out, task->lo, task->mid, task->hi, task->comparator);
+}
+
+/**
+ * @fn void Array::parallelSort(Array *self, Comparator comparator, OperationQueue *queue)
+ * @memberof Array
+ */
+static void parallelSort(Array *self, Comparator comparator, OperationQueue *queue) {
+
+  assert(comparator);
+
+  if (self->count < ARRAY_PARALLEL_SORT_CHUNK << 1) {
+    $(self, stableSort, comparator);
+    return;
+  }
+
+  unshare(self);
+
+  ident *buffer = malloc(self->count * sizeof(ident));
+  assert(buffer);
+
+  ParallelTask tasks[ARRAY_PARALLEL_CHUNKS];
+  size_t bounds[ARRAY_PARALLEL_CHUNKS + 1];
+
+  const size_t chunks = chunk(NULL, self->count, ARRAY_PARALLEL_SORT_CHUNK, bounds);
+
+  for (size_t i = 0; i < chunks; i++) {
+    tasks[i] = (ParallelTask) {
+      .in = self->elements,
+      .out = buffer,
+      .lo = bounds[i],
+      .hi = bounds[i + 1],
+      .comparator = comparator
+    };
+  }
+
+  dispatch(queue, parallelSort_sort, tasks, chunks);
+
+  ident *in = self->elements, *out = buffer;
+
+  for (size_t width = 1; width < chunks; width <<= 1) {
+
+    size_t count = 0;
+    for (size_t i = 0; i < chunks; i += width << 1) {
+      tasks[count++] = (ParallelTask) {
+        .in = in,
+        .out = out,
+        .lo = bounds[i],
+        .mid = bounds[min(i + width, chunks)],
+        .hi = bounds[min(i + (width << 1), chunks)],
+        .comparator = comparator
+      };
+    }
+
+    dispatch(queue, parallelSort_merge, tasks, count);
+
+    ident *swap = in;
+    in = out;
+    out = swap;
+  }
+
+  if (in != self->elements) {
+    memcpy(self->elements, in, self->count * sizeof(ident));
+  }
+
+  free(buffer);
+}
+
+/**
+ * @fn size_t Array::partition(Array *self, Predicate predicate, ident data)
+ * @memberof Array
+ */
+static size_t partition(Array *self, Predicate predicate, ident data) {
+
+  assert(predicate);
+
+  unshare(self);
+
+  ident *rejected = NULL;
+  size_t count = 0, rejections = 0;
+
+  for (size_t i = 0; i < self->count; i++) {
+    if (predicate(self->elements[i], data)) {
+      self->elements[count++] = self->elements[i];
+    } else {
+      if (rejected == NULL) {
+        rejected = malloc((self->count - i) * sizeof(ident));
+        assert(rejected);
+      }
+      rejected[rejections++] = self->elements[i];
+    }
+  }
+
+  if (rejections) {
+    memcpy(self->elements + count, rejected, rejections * sizeof(ident));
+    free(rejected);
+  }
+
+  return count;
+}
+
 /**
  * @fn ident Array::reduce(const Array *self, Reducer reducer, ident accumulator, ident data)
  * @memberof Array
@@ -603,9 +1257,14 @@ static ident reduce(const Array *self, Reducer reducer, ident accumulator, ident
  */
 static void removeAllObjects(Array *self) {
 
-  while (self->count) {
-    $(self, removeLastObject);
+  if (self->references) {
+    relinquish(self);
+
+    self->count = self->capacity = 0;
+    return;
   }
+
+  $(self, removeObjectsInRange, (Range) { 0, self->count });
 }
 
 /**
@@ -655,15 +1314,87 @@ static void removeObjectAtIndex(Array *self, size_t index) {
 
   assert(index < self->count);
 
+  unshare(self);
+
   release(self->elements[index]);
 
-  for (size_t i = index; i < self->count - 1; i++) {
-    self->elements[i] = self->elements[i + 1];
-  }
+  memmove(self->elements + index, self->elements + index + 1, (self->count - index - 1) * sizeof(ident));
 
   self->count--;
 }
 
+/**
+ * @fn void Array::removeObjectsAtIndexes(Array *self, const IndexSet *indexes)
+ * @memberof Array
+ */
+static void removeObjectsAtIndexes(Array *self, const IndexSet *indexes) {
+
+  assert(indexes);
+
+  if (indexes->count == 0) {
+    return;
+  }
+
+  assert(indexes->indexes[indexes->count - 1] < self->count);
+
+  unshare(self);
+
+  size_t count = indexes->indexes[0];
+  for (size_t i = count, j = 0; i < self->count; i++) {
+    if (j < indexes->count && indexes->indexes[j] == i) {
+      release(self->elements[i]);
+      j++;
+    } else {
+      self->elements[count++] = self->elements[i];
+    }
+  }
+
+  self->count = count;
+}
+
+/**
+ * @fn void Array::removeObjectsInRange(Array *self, const Range range)
+ * @memberof Array
+ */
+static void removeObjectsInRange(Array *self, const Range range) {
+
+  assert(range.location >= 0);
+  assert(range.location + range.length <= self->count);
+
+  if (range.length == 0) {
+    return;
+  }
+
+  unshare(self);
+
+  for (size_t i = range.location; i < range.location + range.length; i++) {
+    release(self->elements[i]);
+  }
+
+  const size_t end = range.location + range.length;
+
+  memmove(self->elements + range.location, self->elements + end, (self->count - end) * sizeof(ident));
+
+  self->count -= range.length;
+}
+
+/**
+ * @fn void Array::reserveCapacity(Array *self, size_t capacity)
+ * @memberof Array
+ */
+static void reserveCapacity(Array *self, size_t capacity) {
+
+  unshare(self);
+
+  if (capacity > self->capacity) {
+
+    self->elements = realloc(self->elements, capacity * sizeof(ident));
+    assert(self->elements);
+
+    self->capacity = capacity;
+  }
+}
+
 /**
  * @fn void Array::setObjectAtIndex(Array *self, const ident obj, size_t index)
  * @memberof Array
@@ -672,6 +1403,8 @@ static void setObjectAtIndex(Array *self, const ident obj, size_t index) {
 
   assert(index < self->count);
 
+  unshare(self);
+
   retain(obj);
 
   release(self->elements[index]);
@@ -679,11 +1412,36 @@ static void setObjectAtIndex(Array *self, const ident obj, size_t index) {
   self->elements[index] = obj;
 }
 
+/**
+ * @fn void Array::shrinkToFit(Array *self)
+ * @memberof Array
+ */
+static void shrinkToFit(Array *self) {
+
+  unshare(self);
+
+  if (self->capacity > self->count) {
+
+    if (self->count) {
+      self->elements = realloc(self->elements, self->count * sizeof(ident));
+      assert(self->elements);
+    } else {
+      free(self->elements);
+      self->elements = NULL;
+    }
+
+    self->capacity = self->count;
+  }
+}
+
 /**
  * @fn void Array::sort(Array *self, Comparator comparator)
  * @memberof Array
  */
 static void sort(Array *self, Comparator comparator) {
+
+  unshare(self);
+
   quicksort(self->elements, self->count, sizeof(ident), comparator, NULL);
 }
 
@@ -702,6 +1460,31 @@ static Array *sortedArray(const Array *self, Comparator comparator) {
   return array;
 }
 
+/**
+ * @fn void Array::stableSort(Array *self, Comparator comparator)
+ * @memberof Array
+ */
+static void stableSort(Array *self, Comparator comparator) {
+
+  assert(comparator);
+
+  if (self->count < 2) {
+    return;
+  }
+
+  unshare(self);
+
+  ident *buffer = NULL;
+  if (self->count > ARRAY_SORT_RUN) {
+    buffer = malloc(self->count * sizeof(ident));
+    assert(buffer);
+  }
+
+  mergeSort(self->elements, buffer, self->count, comparator);
+
+  free(buffer);
+}
+
 #pragma mark - Class lifecycle
 
 /**
@@ -718,6 +1501,7 @@ static void initialize(Class *clazz) {
   ((ArrayInterface *) clazz->interface)->addObject = addObject;
   ((ArrayInterface *) clazz->interface)->addObjects = addObjects;
   ((ArrayInterface *) clazz->interface)->addObjectsFromArray = addObjectsFromArray;
+  ((ArrayInterface *) clazz->interface)->addObjectsWithCount = addObjectsWithCount;
   ((ArrayInterface *) clazz->interface)->array = array;
   ((ArrayInterface *) clazz->interface)->arrayWithArray = arrayWithArray;
   ((ArrayInterface *) clazz->interface)->arrayWithCapacity = arrayWithCapacity;
@@ -738,19 +1522,31 @@ static void initialize(Class *clazz) {
   ((ArrayInterface *) clazz->interface)->initWithObjects = initWithObjects;
   ((ArrayInterface *) clazz->interface)->initWithVaList = initWithVaList;
   ((ArrayInterface *) clazz->interface)->insertObjectAtIndex = insertObjectAtIndex;
+  ((ArrayInterface *) clazz->interface)->insertObjectsAtIndexes = insertObjectsAtIndexes;
   ((ArrayInterface *) clazz->interface)->lastObject = lastObject;
   ((ArrayInterface *) clazz->interface)->map = map;
   ((ArrayInterface *) clazz->interface)->mappedArray = mappedArray;
   ((ArrayInterface *) clazz->interface)->objectAtIndex = objectAtIndex;
+  ((ArrayInterface *) clazz->interface)->parallelFilteredArray = parallelFilteredArray;
+  ((ArrayInterface *) clazz->interface)->parallelMap = parallelMap;
+  ((ArrayInterface *) clazz->interface)->parallelMappedArray = parallelMappedArray;
+  ((ArrayInterface *) clazz->interface)->parallelReduce = parallelReduce;
+  ((ArrayInterface *) clazz->interface)->parallelSort = parallelSort;
+  ((ArrayInterface *) clazz->interface)->partition = partition;
   ((ArrayInterface *) clazz->interface)->reduce = reduce;
   ((ArrayInterface *) clazz->interface)->removeAllObjects = removeAllObjects;
   ((ArrayInterface *) clazz->interface)->removeAllObjectsWithEnumerator = removeAllObjectsWithEnumerator;
   ((ArrayInterface *) clazz->interface)->removeLastObject = removeLastObject;
   ((ArrayInterface *) clazz->interface)->removeObject = removeObject;
   ((ArrayInterface *) clazz->interface)->removeObjectAtIndex = removeObjectAtIndex;
+  ((ArrayInterface *) clazz->interface)->removeObjectsAtIndexes = removeObjectsAtIndexes;
+  ((ArrayInterface *) clazz->interface)->removeObjectsInRange = removeObjectsInRange;
+  ((ArrayInterface *) clazz->interface)->reserveCapacity = reserveCapacity;
   ((ArrayInterface *) clazz->interface)->setObjectAtIndex = setObjectAtIndex;
+  ((ArrayInterface *) clazz->interface)->shrinkToFit = shrinkToFit;
   ((ArrayInterface *) clazz->interface)->sort = sort;
   ((ArrayInterface *) clazz->interface)->sortedArray = sortedArray;
+  ((ArrayInterface *) clazz->interface)->stableSort = stableSort;
 }
 
 /**
@@ -25,6 +25,7 @@
 
 #include <stdarg.h>
 
+#include <Objectively/IndexSet.h>
 #include <Objectively/Object.h>
 
 /**
@@ -40,6 +41,8 @@
 typedef struct Array Array;
 typedef struct ArrayInterface ArrayInterface;
 
+typedef struct OperationQueue OperationQueue;
+
 /**
  * @brief A function pointer for Array enumeration (iteration).
  * @param array The Array.
@@ -82,6 +85,13 @@ struct Array {
    * @private
    */
   size_t capacity;
+
+  /**
+   * @brief The number of Arrays sharing `elements`, or `NULL` if this Array owns them outright.
+   * @details Copies share their elements until either is mutated, which then copies them.
+   * @private
+   */
+  size_t *references;
 };
 
 
@@ -122,6 +132,16 @@ struct ArrayInterface {
    */
   void (*addObjectsFromArray)(Array *self, const Array *array);
 
+  /**
+   * @fn void Array::addObjectsWithCount(Array *self, size_t count, const ident *objects)
+   * @brief Adds `count` Objects to this Array, growing it at most once.
+   * @param self The Array.
+   * @param count The count of `objects`.
+   * @param objects The Objects to add.
+   * @memberof Array
+   */
+  void (*addObjectsWithCount)(Array *self, size_t count, const ident *objects);
+
   /**
    * @static
    * @fn Array *Array::array(void)
@@ -316,6 +336,17 @@ struct ArrayInterface {
    */
   void (*insertObjectAtIndex)(Array *self, ident obj, size_t index);
 
+  /**
+   * @fn void Array::insertObjectsAtIndexes(Array *self, const ident *objects, const IndexSet *indexes)
+   * @brief Inserts Objects so that each occupies the corresponding index of `indexes` afterwards.
+   * @param self The Array.
+   * @param objects The Objects to insert, one for each of `indexes`.
+   * @param indexes The indexes of the inserted Objects in the resulting Array.
+   * @remarks Existing Objects are shifted in a single pass, rather than once per insertion.
+   * @memberof Array
+   */
+  void (*insertObjectsAtIndexes)(Array *self, const ident *objects, const IndexSet *indexes);
+
   /**
    * @fn ident Array::lastObject(const Array *self)
    * @param self The Array.
@@ -354,6 +385,92 @@ struct ArrayInterface {
    */
   ident (*objectAtIndex)(const Array *self, size_t index);
 
+  /**
+   * @fn Array *Array::parallelFilteredArray(const Array *self, Predicate predicate, ident data, OperationQueue *queue)
+   * @brief Creates a new Array with elements that pass `predicate`, splitting the work across `queue`.
+   * @param self The Array.
+   * @param predicate The predicate function, which must be safe to call from several threads at once.
+   * @param data User data.
+   * @param queue The OperationQueue, or `NULL` for the shared queue.
+   * @return The new, filtered Array, in the same order as this Array.
+   * @see parallelMappedArray(const Array *, Functor, ident, OperationQueue *)
+   * @memberof Array
+   */
+  Array *(*parallelFilteredArray)(const Array *self, Predicate predicate, ident data, OperationQueue *queue);
+
+  /**
+   * @fn void Array::parallelMap(Array *self, Functor functor, ident data, OperationQueue *queue)
+   * @brief Transforms the elements in this Array in place using `functor`, splitting the work
+   * across `queue`.
+   * @param self The Array.
+   * @param functor The Functor, which must be safe to call from several threads at once.
+   * @param data User data.
+   * @param queue The OperationQueue, or `NULL` for the shared queue.
+   * @see parallelMappedArray(const Array *, Functor, ident, OperationQueue *)
+   * @memberof Array
+   */
+  void (*parallelMap)(Array *self, Functor functor, ident data, OperationQueue *queue);
+
+  /**
+   * @fn Array *Array::parallelMappedArray(const Array *self, Functor functor, ident data, OperationQueue *queue)
+   * @brief Transforms the elements in this Array by `functor`, splitting the work across `queue`.
+   * @param self The Array.
+   * @param functor The Functor, which must be safe to call from several threads at once.
+   * @param data User data.
+   * @param queue The OperationQueue, or `NULL` for the shared queue.
+   * @return An Array containing the transformed elements of this Array.
+   * @remarks The `parallel` methods split this Array into contiguous chunks, one Operation apiece.
+   * The calling thread runs the last chunk itself, and then waits for `queue` to finish the rest.
+   * Chunks are split on cache lines of the output, so that no two threads write the same line.
+   * Arrays too small to benefit run on the calling thread alone.
+   * @remarks The `parallel` methods must not be called from an Operation running on `queue`.
+   * @memberof Array
+   */
+  Array *(*parallelMappedArray)(const Array *self, Functor functor, ident data, OperationQueue *queue);
+
+  /**
+   * @fn ident Array::parallelReduce(const Array *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue)
+   * @brief Reduces this Array, splitting the work across `queue`.
+   * @param self The Array.
+   * @param reducer The Reducer, which must be safe to call from several threads at once.
+   * @param combiner The Reducer which combines the partial reduction of each chunk, in order, into
+   * the accumulator. It must be associative.
+   * @param accumulator The initial accumulator value of each chunk, which must be an identity of
+   * `combiner`.
+   * @param data User data.
+   * @param queue The OperationQueue, or `NULL` for the shared queue.
+   * @return The reduction result.
+   * @see parallelMappedArray(const Array *, Functor, ident, OperationQueue *)
+   * @memberof Array
+   */
+  ident (*parallelReduce)(const Array *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue);
+
+  /**
+   * @fn void Array::parallelSort(Array *self, Comparator comparator, OperationQueue *queue)
+   * @brief Stably sorts this Array in place using `comparator`, splitting the work across `queue`.
+   * @param self The Array.
+   * @param comparator The Comparator, which must be safe to call from several threads at once.
+   * @param queue The OperationQueue to sort chunks of this Array, and then merge them, on, or
+   * `NULL` for the shared queue.
+   * @see parallelMappedArray(const Array *, Functor, ident, OperationQueue *)
+   * @memberof Array
+   */
+  void (*parallelSort)(Array *self, Comparator comparator, OperationQueue *queue);
+
+  /**
+   * @fn size_t Array::partition(Array *self, Predicate predicate, ident data)
+   * @brief Stably partitions this Array in place, so that all elements which pass `predicate`
+   * precede all elements which do not.
+   * @param self The Array.
+   * @param predicate The predicate function.
+   * @param data User data.
+   * @return The number of elements that passed `predicate`, which is also the index of the
+   * first element that did not.
+   * @remarks The relative order of the elements within each partition is preserved.
+   * @memberof Array
+   */
+  size_t (*partition)(Array *self, Predicate predicate, ident data);
+
   /**
    * @fn ident Array::reduce(const Array *self, Reducer reducer, ident accumulator, ident data)
    * @param self The Array.
@@ -409,6 +526,34 @@ struct ArrayInterface {
    */
   void (*removeObjectAtIndex)(Array *self, size_t index);
 
+  /**
+   * @fn void Array::removeObjectsAtIndexes(Array *self, const IndexSet *indexes)
+   * @brief Removes the Objects at the specified indexes.
+   * @param self The Array.
+   * @param indexes The indexes of the Objects to remove.
+   * @remarks The remaining Objects are compacted in a single pass.
+   * @memberof Array
+   */
+  void (*removeObjectsAtIndexes)(Array *self, const IndexSet *indexes);
+
+  /**
+   * @fn void Array::removeObjectsInRange(Array *self, const Range range)
+   * @brief Removes the Objects in the specified Range.
+   * @param self The Array.
+   * @param range The Range of Objects to remove.
+   * @memberof Array
+   */
+  void (*removeObjectsInRange)(Array *self, const Range range);
+
+  /**
+   * @fn void Array::reserveCapacity(Array *self, size_t capacity)
+   * @brief Ensures that this Array can hold `capacity` Objects without growing.
+   * @param self The Array.
+   * @param capacity The desired capacity.
+   * @memberof Array
+   */
+  void (*reserveCapacity)(Array *self, size_t capacity);
+
   /**
    * @fn void Array::setObjectAtIndex(Array *self, const ident obj, size_t index)
    * @brief Replaces the Object at the specified index.
@@ -420,11 +565,20 @@ struct ArrayInterface {
    */
   void (*setObjectAtIndex)(Array *self, const ident obj, size_t index);
 
+  /**
+   * @fn void Array::shrinkToFit(Array *self)
+   * @brief Releases any capacity this Array holds beyond its count.
+   * @param self The Array.
+   * @memberof Array
+   */
+  void (*shrinkToFit)(Array *self);
+
   /**
    * @fn void Array::sort(Array *self, Comparator comparator)
    * @brief Sorts this Array in place using `comparator`.
    * @param self The Array.
    * @param comparator The Comparator.
+   * @remarks The sort is not stable. Use `stableSort` to preserve the order of equal Objects.
    * @memberof Array
    */
   void (*sort)(Array *self, Comparator comparator);
@@ -438,6 +592,16 @@ struct ArrayInterface {
    */
   Array *(*sortedArray)(const Array *self, Comparator comparator);
 
+  /**
+   * @fn void Array::stableSort(Array *self, Comparator comparator)
+   * @brief Stably sorts this Array in place using `comparator`.
+   * @param self The Array.
+   * @param comparator The Comparator.
+   * @remarks Unlike `sort`, Objects which `comparator` orders the same keep their relative order.
+   * @memberof Array
+   */
+  void (*stableSort)(Array *self, Comparator comparator);
+
 };
 
 /**
@@ -0,0 +1,271 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "AutoreleasePool.h"
+
+#define _Class _AutoreleasePool
+
+#define AUTORELEASE_POOL_ALIGNMENT 16
+#define AUTORELEASE_POOL_CHUNK_SIZE 0x4000
+
+/**
+ * @brief A contiguous region of an AutoreleasePool's arena.
+ */
+typedef struct Chunk {
+  struct Chunk *next;
+  size_t size;
+  size_t used;
+} Chunk;
+
+/**
+ * @brief The header preceding each arena Object, chaining them for drain.
+ */
+typedef struct {
+  ident prev;
+} Block;
+
+#define ALIGN(size) \
+  (((size) + AUTORELEASE_POOL_ALIGNMENT - 1) & ~(size_t) (AUTORELEASE_POOL_ALIGNMENT - 1))
+
+#define CHUNK_HEADER ALIGN(sizeof(Chunk))
+#define BLOCK_HEADER ALIGN(sizeof(Block))
+
+static __thread AutoreleasePool *_currentPool;
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+  return NULL;
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+  AutoreleasePool *this = (AutoreleasePool *) self;
+
+  if (_currentPool != this) {
+    fprintf(stderr, "%s: %p is not the current pool\n", __func__, this);
+    abort();
+  }
+
+  $(this, drain);
+
+  _currentPool = this->parent;
+
+  free(this->chunks);
+  free(this->objects);
+
+  super(Object, self, dealloc);
+}
+
+#pragma mark - AutoreleasePool
+
+/**
+ * @fn void AutoreleasePool::add(AutoreleasePool *self, ident obj)
+ * @memberof AutoreleasePool
+ */
+static void add(AutoreleasePool *self, ident obj) {
+
+  if (self->count == self->capacity) {
+    self->capacity = self->capacity ? self->capacity << 1 : 64;
+
+    self->objects = realloc(self->objects, self->capacity * sizeof(ident));
+    assert(self->objects);
+  }
+
+  self->objects[self->count++] = obj;
+}
+
+/**
+ * @fn ident AutoreleasePool::allocate(AutoreleasePool *self, Class *clazz)
+ * @memberof AutoreleasePool
+ */
+static ident allocate(AutoreleasePool *self, Class *clazz) {
+
+  const size_t size = BLOCK_HEADER + ALIGN(clazz->def.instanceSize);
+
+  Chunk *chunk = self->chunks;
+  if (chunk == NULL || chunk->used + size > chunk->size) {
+
+    const size_t chunkSize = CHUNK_HEADER + size > AUTORELEASE_POOL_CHUNK_SIZE ?
+      CHUNK_HEADER + size : AUTORELEASE_POOL_CHUNK_SIZE;
+
+    chunk = malloc(chunkSize);
+    assert(chunk);
+
+    chunk->next = self->chunks;
+    chunk->size = chunkSize;
+    chunk->used = CHUNK_HEADER;
+
+    self->chunks = chunk;
+  }
+
+  Block *block = (Block *) ((char *) chunk + chunk->used);
+  chunk->used += size;
+
+  block->prev = self->last;
+
+  ident obj = (char *) block + BLOCK_HEADER;
+  memset(obj, 0, clazz->def.instanceSize);
+
+  Object *object = _instantiate(clazz, obj);
+  object->flags |= OBJECT_ARENA;
+
+  self->last = obj;
+  return obj;
+}
+
+/**
+ * @fn AutoreleasePool *AutoreleasePool::currentPool(void)
+ * @memberof AutoreleasePool
+ */
+static AutoreleasePool *currentPool(void) {
+  return _currentPool;
+}
+
+/**
+ * @fn void AutoreleasePool::drain(AutoreleasePool *self)
+ * @memberof AutoreleasePool
+ */
+static void drain(AutoreleasePool *self) {
+
+  /* Deallocating an arena object may autorelease others, so repeat until neither remain. */
+  while (self->count || self->last) {
+
+    for (size_t i = 0; i < self->count; i++) {
+      release(self->objects[i]);
+    }
+
+    self->count = 0;
+
+    while (self->last) {
+      Object *object = self->last;
+      self->last = ((Block *) ((char *) object - BLOCK_HEADER))->prev;
+
+      $(object, dealloc);
+    }
+  }
+
+  Chunk *chunk = self->chunks;
+  if (chunk) {
+    while (chunk->next) {
+      Chunk *next = chunk->next;
+      chunk->next = next->next;
+      free(next);
+    }
+
+    chunk->used = CHUNK_HEADER;
+  }
+}
+
+/**
+ * @fn AutoreleasePool *AutoreleasePool::init(AutoreleasePool *self)
+ * @memberof AutoreleasePool
+ */
+static AutoreleasePool *init(AutoreleasePool *self) {
+
+  self = (AutoreleasePool *) super(Object, self, init);
+  if (self) {
+    self->parent = _currentPool;
+    _currentPool = self;
+  }
+
+  return self;
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+  ((ObjectInterface *) clazz->interface)->copy = copy;
+  ((ObjectInterface *) clazz->interface)->dealloc = dealloc;
+
+  ((AutoreleasePoolInterface *) clazz->interface)->add = add;
+  ((AutoreleasePoolInterface *) clazz->interface)->allocate = allocate;
+  ((AutoreleasePoolInterface *) clazz->interface)->currentPool = currentPool;
+  ((AutoreleasePoolInterface *) clazz->interface)->drain = drain;
+  ((AutoreleasePoolInterface *) clazz->interface)->init = init;
+}
+
+/**
+ * @fn Class *AutoreleasePool::_AutoreleasePool(void)
+ * @memberof AutoreleasePool
+ */
+Class *_AutoreleasePool(void) {
+  static Class *clazz;
+  static Once once;
+
+  do_once(&once, {
+    clazz = _initialize(&(const ClassDef) {
+      .name = "AutoreleasePool",
+      .superclass = _Object(),
+      .instanceSize = sizeof(AutoreleasePool),
+      .interfaceOffset = offsetof(AutoreleasePool, interface),
+      .interfaceSize = sizeof(AutoreleasePoolInterface),
+      .initialize = initialize,
+    });
+  });
+
+  return clazz;
+}
+
+#undef _Class
+
+/**
+ * @return The current AutoreleasePool of the calling thread, aborting if there is none.
+ */
+static AutoreleasePool *requireCurrentPool(const char *func) {
+
+  if (_currentPool == NULL) {
+    fprintf(stderr, "%s: no AutoreleasePool in place\n", func);
+    abort();
+  }
+
+  return _currentPool;
+}
+
+ident autorelease(ident obj) {
+
+  if (obj && (((Object *) obj)->flags & OBJECT_ARENA) == 0) {
+    $(requireCurrentPool(__func__), add, obj);
+  }
+
+  return obj;
+}
+
+ident _autoalloc(Class *clazz) {
+  return $(requireCurrentPool(__func__), allocate, clazz);
+}
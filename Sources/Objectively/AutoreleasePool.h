@@ -0,0 +1,193 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/Object.h>
+
+/**
+ * @file
+ * @brief Scoped, per-thread pools of Objects released together.
+ */
+
+typedef struct AutoreleasePool AutoreleasePool;
+typedef struct AutoreleasePoolInterface AutoreleasePoolInterface;
+
+/**
+ * @brief Scoped, per-thread pools of Objects released together.
+ * @details Initializing an AutoreleasePool makes it the current pool of the calling thread, and
+ * deallocating it restores the pool that was current before it. Pools therefore nest, and must
+ * be deallocated in the reverse order they were initialized, on the thread that initialized them.
+ * @details Objects are added to the current pool with `autorelease`, which defers one `release`
+ * until the pool is drained. Short-lived Objects that never escape the pool may instead be
+ * allocated from its arena with `autoalloc`, which costs a pointer bump rather than a `malloc`.
+ * @extends Object
+ * @ingroup Core
+ */
+struct AutoreleasePool {
+
+  /**
+   * @brief The superclass.
+   */
+  Object object;
+
+  /**
+   * @brief The interface.
+   * @protected
+   */
+  AutoreleasePoolInterface *interface;
+
+  /**
+   * @brief The pool that was current when this one was initialized.
+   * @private
+   */
+  AutoreleasePool *parent;
+
+  /**
+   * @brief The Objects awaiting `release`.
+   * @private
+   */
+  ident *objects;
+
+  /**
+   * @brief The count of `objects`.
+   * @private
+   */
+  size_t count;
+
+  /**
+   * @brief The capacity of `objects`.
+   * @private
+   */
+  size_t capacity;
+
+  /**
+   * @brief The chunks of the arena, most recent first.
+   * @private
+   */
+  ident chunks;
+
+  /**
+   * @brief The most recently allocated arena Object.
+   * @private
+   */
+  ident last;
+};
+
+/**
+ * @brief The AutoreleasePool interface.
+ */
+struct AutoreleasePoolInterface {
+
+  /**
+   * @brief The superclass interface.
+   */
+  ObjectInterface objectInterface;
+
+  /**
+   * @fn void AutoreleasePool::add(AutoreleasePool *self, ident obj)
+   * @brief Adds the given Object to this AutoreleasePool, to be released when it is drained.
+   * @param self The AutoreleasePool.
+   * @param obj The Object.
+   * @memberof AutoreleasePool
+   */
+  void (*add)(AutoreleasePool *self, ident obj);
+
+  /**
+   * @fn ident AutoreleasePool::allocate(AutoreleasePool *self, Class *clazz)
+   * @brief Instantiates `clazz` in this AutoreleasePool's arena.
+   * @param self The AutoreleasePool.
+   * @param clazz The Class.
+   * @return The uninitialized instance, owned by this AutoreleasePool.
+   * @remarks The instance is not reference counted: `retain` and `release` have no effect on it,
+   * and it is deallocated when this AutoreleasePool is drained. It MUST NOT be referenced beyond
+   * that. Use `alloc` for anything that might, such as an Object that is cached or returned.
+   * @memberof AutoreleasePool
+   */
+  ident (*allocate)(AutoreleasePool *self, Class *clazz);
+
+  /**
+   * @static
+   * @fn AutoreleasePool *AutoreleasePool::currentPool(void)
+   * @return The current AutoreleasePool of the calling thread, or `NULL`.
+   * @memberof AutoreleasePool
+   */
+  AutoreleasePool *(*currentPool)(void);
+
+  /**
+   * @fn void AutoreleasePool::drain(AutoreleasePool *self)
+   * @brief Releases the Objects added to this AutoreleasePool, and deallocates its arena.
+   * @param self The AutoreleasePool.
+   * @remarks Objects released here may add others to this AutoreleasePool as they are
+   * deallocated. Those are released by this same drain.
+   * @memberof AutoreleasePool
+   */
+  void (*drain)(AutoreleasePool *self);
+
+  /**
+   * @fn AutoreleasePool *AutoreleasePool::init(AutoreleasePool *self)
+   * @brief Initializes this AutoreleasePool, and makes it the current pool of the calling thread.
+   * @param self The AutoreleasePool.
+   * @return The initialized AutoreleasePool, or `NULL` on error.
+   * @memberof AutoreleasePool
+   */
+  AutoreleasePool *(*init)(AutoreleasePool *self);
+};
+
+/**
+ * @fn Class *AutoreleasePool::_AutoreleasePool(void)
+ * @brief The AutoreleasePool archetype.
+ * @return The AutoreleasePool Class.
+ * @memberof AutoreleasePool
+ */
+OBJECTIVELY_EXPORT Class *_AutoreleasePool(void);
+
+/**
+ * @brief Adds the given Object to the current AutoreleasePool of the calling thread.
+ * @return The Object.
+ * @remarks Aborts if the calling thread has no AutoreleasePool.
+ */
+OBJECTIVELY_EXPORT ident autorelease(ident obj);
+
+/**
+ * @brief Instantiates a type in the arena of the current AutoreleasePool.
+ * @remarks Aborts if the calling thread has no AutoreleasePool.
+ * @see AutoreleasePool::allocate(AutoreleasePool *, Class *)
+ */
+OBJECTIVELY_EXPORT ident _autoalloc(Class *clazz);
+
+/**
+ * @brief Allocate an instance of `type` in the arena of the current AutoreleasePool.
+ */
+#define autoalloc(type) \
+  ((type *) _autoalloc(_##type()))
+
+/**
+ * @brief Wraps the given statements in a new AutoreleasePool, which is drained after them.
+ * @remarks The statements may contain commas, so that a block can be passed as-is.
+ */
+#define autoreleasepool(...) { \
+  AutoreleasePool *_pool = $(alloc(AutoreleasePool), init); \
+    __VA_ARGS__; \
+  release(_pool); \
+}
@@ -61,7 +61,7 @@ static Boole *False(void) {
   static Once once;
 
   do_once(&once, {
-    _False = (Boole *) $((Object *) alloc(Boole), init);
+    _False = immortalize($((Object *) alloc(Boole), init));
     _False->value = false;
   });
 
@@ -79,7 +79,7 @@ static Boole *True(void) {
   static Once once;
 
   do_once(&once, {
-    _True = (Boole *) $((Object *) alloc(Boole), init);
+    _True = immortalize($((Object *) alloc(Boole), init));
     _True->value = true;
   });
 
@@ -101,8 +101,13 @@ static Boole *valueof(bool value) {
  */
 static void destroy(Class *clazz) {
 
-  release(_False);
-  release(_True);
+  if (_False) {
+    $((Object *) _False, dealloc);
+  }
+
+  if (_True) {
+    $((Object *) _True, dealloc);
+  }
 }
 
 /**
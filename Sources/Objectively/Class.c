@@ -26,6 +26,7 @@
 #include <assert.h>
 #include <dlfcn.h>
 #include <pthread.h>
+#include <signal.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
@@ -39,12 +40,24 @@
 #endif
 
 #include "Class.h"
+#include "Hash.h"
+#include "Instrumentation.h"
 #include "Object.h"
 
 size_t _pageSize;
 
 static Class *_classes;
 
+/**
+ * @brief The number of Classes ever initialized, which numbers the next.
+ */
+static size_t _classCount;
+
+/**
+ * @brief True if each Class allocates its instances from a Slab.
+ */
+static bool _slabs;
+
 /**
  * @brief Guards the structure of `_classes`. MUST NOT be held across `dlsym`,
  * `dlopen`, or a Class initializer, each of which can reenter `_initialize`.
@@ -70,6 +83,193 @@ struct ClassImage {
  */
 static ClassImage *_images;
 
+/**
+ * @brief An open-addressed index of names, which `classForName` probes without
+ * locking. Written only under `_classesLock`, and never resized in place: a
+ * full index is copied and the copy published, so that a reader never sees a
+ * slot move. The index it replaced is retired rather than freed, because a
+ * reader may still be probing it.
+ */
+typedef struct ClassIndex ClassIndex;
+struct ClassIndex {
+  const char *(*name)(const ident slot);
+  size_t capacity;
+  size_t count;
+  ClassIndex *retired;
+  ident slots[];
+};
+
+#define CLASS_INDEX_DEFAULT_CAPACITY 256
+
+/**
+ * @brief Marks a slot whose entry was removed, so that probing continues past it.
+ */
+static char _tombstone;
+#define CLASS_INDEX_TOMBSTONE ((ident) &_tombstone)
+
+/**
+ * @brief The index of initialized Classes, by name.
+ */
+static ClassIndex *_classIndex;
+
+/**
+ * @brief A name that no image could resolve, owned by `_missingNames`.
+ */
+typedef struct MissingName MissingName;
+struct MissingName {
+  MissingName *next;
+  char name[];
+};
+
+/**
+ * @brief Every MissingName, including those dropped from `_missingIndex`. These
+ * are reused rather than freed, since a retired index may still be probed for
+ * them, and so their number is capped.
+ */
+static MissingName *_missingNames;
+static size_t _missingNamesCount;
+
+#define CLASS_MISSING_NAMES_MAX 1024
+
+/**
+ * @brief The index of names that no image could resolve, so that asking again
+ * does not repeat the `dlsym` of each one. Discarded by `addClassImage`, since
+ * the new image may resolve any of them.
+ */
+static ClassIndex *_missingIndex;
+
+/**
+ * @return The name of the Class in `slot`.
+ */
+static const char *className(const ident slot) {
+  return ((Class *) slot)->def.name;
+}
+
+/**
+ * @return The name of the MissingName in `slot`.
+ */
+static const char *missingName(const ident slot) {
+  return ((MissingName *) slot)->name;
+}
+
+/**
+ * @return A new, empty ClassIndex with the given capacity, which must be a power of two.
+ */
+static ClassIndex *createIndex(const char *(*name)(const ident slot), size_t capacity) {
+
+  ClassIndex *index = calloc(1, sizeof(ClassIndex) + capacity * sizeof(ident));
+  assert(index);
+
+  index->name = name;
+  index->capacity = capacity;
+
+  return index;
+}
+
+/**
+ * @brief Frees the given ClassIndex, and every index it retired.
+ */
+static void destroyIndex(ClassIndex *index) {
+
+  while (index) {
+    ClassIndex *retired = index->retired;
+    free(index);
+    index = retired;
+  }
+}
+
+/**
+ * @return The entry for `name` in the given ClassIndex, or `NULL`.
+ * @remarks Safe to call without holding `_classesLock`.
+ */
+static ident lookup(const ClassIndex *index, const char *name) {
+
+  const size_t mask = index->capacity - 1;
+
+  for (size_t i = Hash64ForCString(Hash64Seed(), name) & mask;; i = (i + 1) & mask) {
+
+    const ident slot = __atomic_load_n(&index->slots[i], __ATOMIC_ACQUIRE);
+    if (slot == NULL) {
+      return NULL;
+    }
+
+    if (slot != CLASS_INDEX_TOMBSTONE && strcmp(index->name(slot), name) == 0) {
+      return slot;
+    }
+  }
+}
+
+/**
+ * @brief Adds `entry` to the ClassIndex at `index`, replacing any entry of the same name.
+ * @remarks The caller MUST hold `_classesLock`.
+ */
+static void insert(ClassIndex **index, ident entry) {
+
+  ClassIndex *in = *index;
+
+  /* Tombstones count toward the load, since probing cannot stop on them. */
+  if ((in->count + 1) * 4 > in->capacity * 3) {
+
+    size_t live = 0;
+    for (size_t i = 0; i < in->capacity; i++) {
+      if (in->slots[i] && in->slots[i] != CLASS_INDEX_TOMBSTONE) {
+        live++;
+      }
+    }
+
+    ClassIndex *out = createIndex(in->name, live * 2 >= in->capacity ? in->capacity << 1 : in->capacity);
+    out->retired = in;
+
+    for (size_t i = 0; i < in->capacity; i++) {
+      if (in->slots[i] && in->slots[i] != CLASS_INDEX_TOMBSTONE) {
+        insert(&out, in->slots[i]);
+      }
+    }
+
+    __atomic_store_n(index, out, __ATOMIC_RELEASE);
+    in = out;
+  }
+
+  const char *name = in->name(entry);
+  const size_t mask = in->capacity - 1;
+
+  for (size_t i = Hash64ForCString(Hash64Seed(), name) & mask;; i = (i + 1) & mask) {
+
+    const ident slot = in->slots[i];
+    if (slot == NULL || (slot != CLASS_INDEX_TOMBSTONE && strcmp(in->name(slot), name) == 0)) {
+
+      if (slot == NULL) {
+        in->count++;
+      }
+
+      __atomic_store_n(&in->slots[i], entry, __ATOMIC_RELEASE);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Removes `entry` from the given ClassIndex, if it is there.
+ * @remarks The caller MUST hold `_classesLock`.
+ */
+static void delete(ClassIndex *index, const ident entry) {
+
+  const size_t mask = index->capacity - 1;
+
+  for (size_t i = Hash64ForCString(Hash64Seed(), index->name(entry)) & mask;; i = (i + 1) & mask) {
+
+    const ident slot = index->slots[i];
+    if (slot == NULL) {
+      break;
+    }
+
+    if (slot == entry) {
+      __atomic_store_n(&index->slots[i], CLASS_INDEX_TOMBSTONE, __ATOMIC_RELEASE);
+      break;
+    }
+  }
+}
+
 /**
  * @brief Called `atexit` to teardown Objectively.
  */
@@ -90,6 +290,8 @@ static void teardown(void) {
 
     Class *next = c->next;
 
+    SlabDestroy(c->slab);
+
     free(c->interface);
     free(c);
 
@@ -105,6 +307,26 @@ static void teardown(void) {
 
     i = next;
   }
+
+  destroyIndex(_classIndex);
+  destroyIndex(_missingIndex);
+
+  MissingName *m = _missingNames;
+  while (m) {
+
+    MissingName *next = m->next;
+
+    free(m);
+
+    m = next;
+  }
+}
+
+/**
+ * @brief The signal handler for `OBJECTIVELY_INSTRUMENTATION_SIGNAL`.
+ */
+static void dumpInstrumentation(int signal) {
+  InstrumentationDump(fileno(stderr));
 }
 
 /**
@@ -114,12 +336,25 @@ static void setup(void) {
 
   _classes = NULL;
 
+  _classIndex = createIndex(className, CLASS_INDEX_DEFAULT_CAPACITY);
+  _missingIndex = createIndex(missingName, CLASS_INDEX_DEFAULT_CAPACITY);
+
 #if !defined(_SC_PAGESIZE)
   _pageSize = 4096;
 #else
   _pageSize = sysconf(_SC_PAGESIZE);
 #endif
 
+  const char *allocator = getenv("OBJECTIVELY_ALLOCATOR");
+  if (allocator && strcmp(allocator, "slab") == 0) {
+    _slabs = true;
+  }
+
+  const char *instrumentationSignal = getenv("OBJECTIVELY_INSTRUMENTATION_SIGNAL");
+  if (instrumentationSignal) {
+    signal(atoi(instrumentationSignal), dumpInstrumentation);
+  }
+
   atexit(teardown);
 }
 
@@ -148,10 +383,17 @@ static const ident imageForAddress(const ident address) {
   return NULL;
 }
 
-Class *_initialize(const ClassDef *def) {
-
+/**
+ * @brief Runs `setup` once, before anything that depends on it.
+ */
+static void setupOnce(void) {
   static Once once;
   do_once(&once, setup());
+}
+
+Class *_initialize(const ClassDef *def) {
+
+  setupOnce();
 
   assert(def);
   assert(def->name);
@@ -159,11 +401,19 @@ Class *_initialize(const ClassDef *def) {
   assert(def->interfaceSize);
   assert(def->interfaceOffset);
 
-  Class *clazz = calloc(1, sizeof(Class));
+  const size_t depth = def->superclass ? def->superclass->depth + 1 : 0;
+
+  Class *clazz = calloc(1, sizeof(Class) + (depth + 1) * sizeof(Class *));
   assert(clazz);
 
   clazz->def = *def;
 
+  clazz->depth = depth;
+  if (depth) {
+    memcpy(clazz->ancestors, def->superclass->ancestors, depth * sizeof(Class *));
+  }
+  clazz->ancestors[depth] = clazz;
+
   clazz->interface = calloc(1, def->interfaceSize);
   assert(clazz->interface);
 
@@ -180,6 +430,10 @@ Class *_initialize(const ClassDef *def) {
     clazz->def.initialize(clazz);
   }
 
+  if (_slabs) {
+    clazz->slab = SlabCreate(def->instanceSize);
+  }
+
   /* def.name is a literal in the declaring image, where the ClassDef itself is
    * a compound literal with automatic storage. */
   clazz->image = imageForAddress((ident) def->name);
@@ -188,8 +442,12 @@ Class *_initialize(const ClassDef *def) {
    * reach other archetypes, and so this, before that Class is published. */
   pthread_mutex_lock(&_classesLock);
 
+  clazz->index = _classCount++;
+
   clazz->next = _classes;
-  _classes = clazz;
+  __atomic_store_n(&_classes, clazz, __ATOMIC_RELEASE);
+
+  insert(&_classIndex, clazz);
 
   pthread_mutex_unlock(&_classesLock);
 
@@ -198,7 +456,13 @@ Class *_initialize(const ClassDef *def) {
 
 ident _alloc(Class *clazz) {
 
-  ident obj = calloc(1, clazz->def.instanceSize);
+  InstrumentationAlloc(clazz);
+
+  return _instantiate(clazz, clazz->slab ? SlabAlloc(clazz->slab) : calloc(1, clazz->def.instanceSize));
+}
+
+ident _instantiate(Class *clazz, ident obj) {
+
   assert(obj);
 
   Object *object = (Object *) obj;
@@ -218,20 +482,29 @@ ident _alloc(Class *clazz) {
 ident _cast(const Class *clazz, const ident obj) {
 
   if (obj) {
-    const Class *c = ((Object *) obj)->clazz;
-    while (c) {
+    assert(issubclassof(((Object *) obj)->clazz, clazz));
+  }
 
-      // as a special case, we optimize for _Object
-      if (c == clazz || clazz == _Object()) {
-        break;
-      }
+  return (ident) obj;
+}
 
-      c = c->def.superclass;
-    }
-    assert(c);
+void _dealloc(ident obj) {
+
+  const Object *object = (Object *) obj;
+
+  /* The arena that owns it is freed all at once, when its pool is drained. */
+  if (object->flags & OBJECT_ARENA) {
+    return;
   }
 
-  return (ident) obj;
+  InstrumentationDealloc(object->clazz);
+
+  Slab *slab = object->clazz->slab;
+  if (slab) {
+    SlabFree(slab, obj);
+  } else {
+    free(obj);
+  }
 }
 
 void addClassImage(ident handle, const ident address) {
@@ -239,6 +512,8 @@ void addClassImage(ident handle, const ident address) {
   assert(handle);
   assert(address);
 
+  setupOnce();
+
   const ident image = imageForAddress(address);
   if (image == NULL) {
     fprintf(stderr, "%s: no image contains %p\n", __func__, address);
@@ -256,6 +531,17 @@ void addClassImage(ident handle, const ident address) {
   classImage->next = __atomic_load_n(&_images, __ATOMIC_RELAXED);
   while (!__atomic_compare_exchange_n(&_images, &classImage->next, classImage, 1,
       __ATOMIC_RELEASE, __ATOMIC_RELAXED)) ;
+
+  /* Any name that no image could resolve, this one might. The names themselves
+   * outlive the index, which a concurrent classForName may still be probing. */
+  pthread_mutex_lock(&_classesLock);
+
+  ClassIndex *missingIndex = createIndex(missingName, CLASS_INDEX_DEFAULT_CAPACITY);
+  missingIndex->retired = _missingIndex;
+
+  __atomic_store_n(&_missingIndex, missingIndex, __ATOMIC_RELEASE);
+
+  pthread_mutex_unlock(&_classesLock);
 }
 
 void removeClassImage(ident handle) {
@@ -288,13 +574,27 @@ void removeClassImage(ident handle) {
     abort();
   }
 
+  /* Unlinked without touching the next of the Class removed, so that
+   * enumerateClasses, which does not lock, always has a way forward. A Class of
+   * the same name from another image was shadowed by the one removed, and
+   * answers in its place, as it would have from the list. */
   Class **classes = &_classes;
   while (*classes) {
     Class *clazz = *classes;
 
     if (clazz->image == image) {
-      *classes = clazz->next;
-      clazz->next = NULL;
+      __atomic_store_n(classes, clazz->next, __ATOMIC_RELEASE);
+
+      if (lookup(_classIndex, clazz->def.name) == clazz) {
+        delete(_classIndex, clazz);
+
+        for (Class *c = _classes; c; c = c->next) {
+          if (c->image != image && strcmp(c->def.name, clazz->def.name) == 0) {
+            insert(&_classIndex, c);
+            break;
+          }
+        }
+      }
     } else {
       classes = &clazz->next;
     }
@@ -303,32 +603,38 @@ void removeClassImage(ident handle) {
   pthread_mutex_unlock(&_classesLock);
 }
 
+void enumerateClasses(ClassEnumerator enumerator, ident data) {
+
+  assert(enumerator);
+
+  for (Class *c = __atomic_load_n(&_classes, __ATOMIC_ACQUIRE); c; c = __atomic_load_n(&c->next, __ATOMIC_ACQUIRE)) {
+    enumerator(c, data);
+  }
+}
+
 Class *classForName(const char *name) {
 
   if (name) {
-    pthread_mutex_lock(&_classesLock);
 
-    Class *c = _classes;
-    while (c) {
-      if (strcmp(name, c->def.name) == 0) {
-        break;
-      }
-      c = c->next;
-    }
-
-    pthread_mutex_unlock(&_classesLock);
+    setupOnce();
 
+    Class *c = lookup(__atomic_load_n(&_classIndex, __ATOMIC_ACQUIRE), name);
     if (c) {
       return c;
     }
 
+    if (lookup(__atomic_load_n(&_missingIndex, __ATOMIC_ACQUIRE), name)) {
+      return NULL;
+    }
+
     char *s;
     if (asprintf(&s, "_%s", name) > 0) {
       Class *clazz = NULL;
       Class *(*archetype)(void) = NULL;
 
-      for (ClassImage *i = __atomic_load_n(&_images, __ATOMIC_ACQUIRE);
-          i && archetype == NULL; i = i->next) {
+      ClassImage *images = __atomic_load_n(&_images, __ATOMIC_ACQUIRE);
+
+      for (ClassImage *i = images; i && archetype == NULL; i = i->next) {
 
         ident handle = __atomic_load_n(&i->handle, __ATOMIC_ACQUIRE);
         if (handle) {
@@ -349,6 +655,37 @@ Class *classForName(const char *name) {
 
       if (archetype) {
         clazz = archetype();
+      } else {
+        pthread_mutex_lock(&_classesLock);
+
+        /* An image added since the walk began may resolve this name, and has
+         * already discarded the index this miss would have been recorded in. */
+        if (__atomic_load_n(&_images, __ATOMIC_RELAXED) == images && lookup(_missingIndex, name) == NULL) {
+
+          MissingName *missing = _missingNames;
+          while (missing && strcmp(missing->name, name)) {
+            missing = missing->next;
+          }
+
+          if (missing == NULL && _missingNamesCount < CLASS_MISSING_NAMES_MAX) {
+            const size_t size = strlen(name) + 1;
+
+            missing = malloc(sizeof(MissingName) + size);
+            assert(missing);
+
+            memcpy(missing->name, name, size);
+
+            missing->next = _missingNames;
+            _missingNames = missing;
+            _missingNamesCount++;
+          }
+
+          if (missing) {
+            insert(&_missingIndex, missing);
+          }
+        }
+
+        pthread_mutex_unlock(&_classesLock);
       }
 
       free(s);
@@ -359,6 +696,17 @@ Class *classForName(const char *name) {
   return NULL;
 }
 
+ident immortalize(ident obj) {
+
+  Object *object = cast(Object, obj);
+
+  assert(object);
+
+  __atomic_or_fetch(&object->flags, OBJECT_IMMORTAL, __ATOMIC_RELEASE);
+
+  return obj;
+}
+
 ident release(ident obj) {
 
   if (obj) {
@@ -366,6 +714,10 @@ ident release(ident obj) {
 
     assert(object);
 
+    if (object->flags & (OBJECT_ARENA | OBJECT_IMMORTAL)) {
+      return NULL;
+    }
+
     if (__atomic_fetch_sub(&object->referenceCount, 1, __ATOMIC_RELEASE) == 1) {
       __atomic_thread_fence(__ATOMIC_ACQUIRE);
       $(object, dealloc);
@@ -381,6 +733,10 @@ ident retain(ident obj) {
 
   assert(object);
 
+  if (object->flags & (OBJECT_ARENA | OBJECT_IMMORTAL)) {
+    return obj;
+  }
+
   /* A reference count of zero means another thread is already inside dealloc,
    * and the caller is retaining memory that is about to be freed. */
   unsigned int referenceCount = __atomic_load_n(&object->referenceCount, __ATOMIC_RELAXED);
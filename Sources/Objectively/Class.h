@@ -25,6 +25,7 @@
 
 #include <Objectively/Types.h>
 #include <Objectively/Once.h>
+#include <Objectively/Slab.h>
 
 /**
  * @file
@@ -116,8 +117,53 @@ struct Class {
    * image calling `alloc` arrive here alike. `removeClassImage` matches on it.
    */
   ident image;
+
+  /**
+   * @brief The Slab that instances of this Class are allocated from, or `NULL`.
+   * @details Set by `_initialize` when the environment variable `OBJECTIVELY_ALLOCATOR`
+   * is `slab`. The variable is read once, so every instance is freed the way it was
+   * allocated.
+   * @see SlabGetStats(const Slab *)
+   */
+  Slab *slab;
+
+  /**
+   * @brief The order in which this Class was initialized, from `0`.
+   */
+  size_t index;
+
+  /**
+   * @brief The number of live instances, as last reported by any thread.
+   * @private
+   */
+  size_t liveInstances;
+
+  /**
+   * @brief The greatest number of live instances reported.
+   * @private
+   */
+  size_t highWaterMark;
+
+  /**
+   * @brief The number of superclasses above this Class; `0` for Object.
+   */
+  size_t depth;
+
+  /**
+   * @brief The ancestor display of this Class, indexed by depth: `ancestors[0]` is Object, and
+   * `ancestors[depth]` is this Class.
+   * @details Computed once by `_initialize`, so that `issubclassof` is a single compare.
+   */
+  const Class *ancestors[];
 };
 
+/**
+ * @brief The Class enumerator type.
+ * @param clazz The Class.
+ * @param data User data.
+ */
+typedef void (*ClassEnumerator)(Class *clazz, ident data);
+
 /**
  * @brief Initializes the given Class.
  * @param clazz The Class descriptor.
@@ -130,11 +176,23 @@ OBJECTIVELY_EXPORT Class* _initialize(const ClassDef *clazz);
  */
 OBJECTIVELY_EXPORT ident _alloc(Class *clazz);
 
+/**
+ * @brief Instantiate a type through the given Class, in zero-filled memory provided by the
+ * caller, which is then responsible for freeing it.
+ */
+OBJECTIVELY_EXPORT ident _instantiate(Class *clazz, ident mem);
+
 /**
  * @brief Perform a type-checking cast.
  */
 OBJECTIVELY_EXPORT ident _cast(const Class *clazz, const ident obj);
 
+/**
+ * @brief Free an instance allocated by `_alloc`.
+ * @remarks This is the last thing `Object::dealloc` does; nothing else should call it.
+ */
+OBJECTIVELY_EXPORT void _dealloc(ident obj);
+
 /**
  * @brief Registers an image that provides Classes, e.g. a plugin.
  * @param handle A handle from `dlopen`.
@@ -180,17 +238,41 @@ OBJECTIVELY_EXPORT void addClassImage(ident handle, const ident address);
  */
 OBJECTIVELY_EXPORT void removeClassImage(ident handle);
 
+/**
+ * @brief Enumerates every initialized Class, most recently initialized first.
+ * @param enumerator The ClassEnumerator.
+ * @param data User data.
+ * @remarks Does not lock, so that it may be called from a signal handler. A Class initialized
+ * or unregistered meanwhile may or may not be enumerated.
+ */
+OBJECTIVELY_EXPORT void enumerateClasses(ClassEnumerator enumerator, ident data);
+
 /**
  * @return The Class with the given name, or `NULL` if no such Class has been initialized.
  * @remarks Classes already initialized are answered first, then each registered
  * image, then the process-wide namespace.
+ * @remarks Initialized Classes are found through a hashed index, without taking a
+ * lock. A name that nothing resolves is remembered, and answered `NULL` directly
+ * until the next `addClassImage`. An image loaded `RTLD_GLOBAL` without being
+ * registered does not clear it, so register any image that provides Classes.
  */
 OBJECTIVELY_EXPORT Class *classForName(const char *name);
 
+/**
+ * @brief Makes the given Object immortal, so that `retain` and `release` no longer affect it.
+ * @return The Object.
+ * @remarks Intended for singletons, and to be called before the Object is published. An immortal
+ * Object is deallocated only by invoking `Object::dealloc` directly, typically from the `destroy`
+ * of its Class.
+ */
+OBJECTIVELY_EXPORT ident immortalize(ident obj);
+
 /**
  * @brief Atomically decrement the given Object's reference count. If the
  * resulting reference count is `0`, the Object is deallocated.
  * @return This function always returns `NULL`.
+ * @remarks Immortal Objects, and those owned by an AutoreleasePool arena, are not reference
+ * counted.
  */
 OBJECTIVELY_EXPORT ident release(ident obj);
 
@@ -219,6 +301,15 @@ OBJECTIVELY_EXPORT size_t _pageSize;
 #define isobject(obj) \
   (obj && *((unsigned int *) obj) == OBJECTIVELY_MAGIC)
 
+/**
+ * @brief Test if `clazz` is `superclass`, or descends from it.
+ */
+#define issubclassof(clazz, superclass) \
+  ({ \
+    const Class *_c = (clazz), *_s = (superclass); \
+    _s->depth <= _c->depth && _c->ancestors[_s->depth] == _s; \
+  })
+
 /**
  * @brief Test if the given pointer is an instance of the specified type.
  */
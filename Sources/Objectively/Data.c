@@ -28,6 +28,7 @@
 
 #include "Data.h"
 #include "Hash.h"
+#include "Slice.h"
 
 #define _Class _Data
 
@@ -71,11 +72,11 @@ static int hash(const Object *self) {
 
   Data *this = (Data *) self;
 
-  int hash = HASH_SEED;
-  hash = HashForInteger(hash, this->length);
-
-  const Range range = { 0, this->length };
-  hash = HashForBytes(hash, this->bytes, range);
+  int hash = __atomic_load_n(&this->hash, __ATOMIC_RELAXED);
+  if (hash == 0) {
+    hash = (int) Hash64ForBytes(Hash64Seed(), this->bytes, this->length);
+    __atomic_store_n(&this->hash, hash, __ATOMIC_RELAXED);
+  }
 
   return hash;
 }
@@ -89,6 +90,10 @@ static bool isEqual(const Object *self, const Object *other) {
     return true;
   }
 
+  if (other && $(other, isKindOfClass, _Slice())) {
+    return $(other, isEqual, self);
+  }
+
   if (other && $(other, isKindOfClass, _Data())) {
 
     const Data *this = (Data *) self;
@@ -348,8 +353,14 @@ static Data *initWithData(Data *self, const Data *data) {
  */
 static void setLength(Data *self, size_t length) {
 
-  const size_t newCapacity = (length / _pageSize + 1) * _pageSize;
-  if (newCapacity > self->capacity) {
+  self->hash = 0;
+
+  if (length > self->capacity) {
+
+    size_t newCapacity = self->capacity << 1;
+    if (newCapacity < length) {
+      newCapacity = length;
+    }
 
     if (self->bytes == NULL) {
       self->bytes = calloc(newCapacity, sizeof(uint8_t));
@@ -381,6 +392,34 @@ static void setLength(Data *self, size_t length) {
   self->length = length;
 }
 
+/**
+ * @fn void Data::shrinkToFit(Data *self)
+ * @memberof Data
+ */
+static void shrinkToFit(Data *self) {
+
+  if (self->destroy == free && self->capacity > self->length) {
+
+    if (self->length) {
+      self->bytes = realloc(self->bytes, self->length);
+      assert(self->bytes);
+    } else {
+      free(self->bytes);
+      self->bytes = NULL;
+    }
+
+    self->capacity = self->length;
+  }
+}
+
+/**
+ * @fn Slice *Data::slice(const Data *self, const Range range)
+ * @memberof Data
+ */
+static Slice *slice(const Data *self, const Range range) {
+  return $(alloc(Slice), initWithData, self, range);
+}
+
 #pragma mark - Class lifecycle
 
 /**
@@ -409,6 +448,8 @@ static void initialize(Class *clazz) {
   ((DataInterface *) clazz->interface)->initWithCapacity = initWithCapacity;
   ((DataInterface *) clazz->interface)->initWithData = initWithData;
   ((DataInterface *) clazz->interface)->setLength = setLength;
+  ((DataInterface *) clazz->interface)->shrinkToFit = shrinkToFit;
+  ((DataInterface *) clazz->interface)->slice = slice;
   ((DataInterface *) clazz->interface)->writeToFile = writeToFile;
 }
 
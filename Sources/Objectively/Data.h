@@ -36,6 +36,7 @@
  */
 typedef struct Data Data;
 typedef struct DataInterface DataInterface;
+typedef struct Slice Slice;
 
 /**
  * @brief Data may optionally reference destructor to be called on `dealloc`.
@@ -80,6 +81,14 @@ struct Data {
    * @private
    */
   size_t capacity;
+
+  /**
+   * @brief The hash of `bytes`, or `0` if it is yet to be computed.
+   * @details Computed on demand by `Object::hash`, and cleared by `setLength`, through which all
+   * of Data's mutations pass. Writing to `bytes` directly does not clear it.
+   * @private
+   */
+  int hash;
 };
 
 
@@ -260,6 +269,26 @@ struct DataInterface {
    */
   void (*setLength)(Data *self, size_t length);
 
+  /**
+   * @fn void Data::shrinkToFit(Data *self)
+   * @brief Reduces the capacity of this Data to its length.
+   * @param self The Data.
+   * @remarks Data grows geometrically as it is appended to. Call this once it is complete, to
+   * release the excess. Data that does not own its bytes is unaffected.
+   * @memberof Data
+   */
+  void (*shrinkToFit)(Data *self);
+
+  /**
+   * @fn Slice *Data::slice(const Data *self, const Range range)
+   * @param self The Data.
+   * @param range The range of this Data, in bytes.
+   * @return A new Slice of the given range, which shares the storage of this Data.
+   * @see Slice::initWithData(Slice *, const Data *, const Range)
+   * @memberof Data
+   */
+  Slice *(*slice)(const Data *self, const Range range);
+
   /**
    * @fn bool Data::writeToFile(const Data *self, const char *path)
    * @brief Writes this Data to `path`.
@@ -24,18 +24,195 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "Dictionary.h"
 #include "Hash.h"
 #include "String.h"
+#include "StringBuilder.h"
 #include "Null.h"
 
 #define _Class _Dictionary
 
 #define DICTIONARY_DEFAULT_CAPACITY 64
-#define DICTIONARY_GROW_FACTOR 2.0
 #define DICTIONARY_MAX_LOAD 0.75f
 
+/**
+ * @return The 64-bit hash of `key`.
+ */
+static inline size_t hashForKey(const ident key) {
+  return Hash64ForObject(Hash64Seed(), key);
+}
+
+/**
+ * @return The entry for `key`, or the vacant entry at which it would be inserted.
+ * @remarks The table must not be empty, nor full.
+ */
+static DictionaryEntry *entryForKey(const Dictionary *self, const ident key, size_t hash) {
+
+  const size_t mask = self->capacity - 1;
+
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+
+    DictionaryEntry *entry = self->elements + i;
+    if (entry->key == NULL) {
+      return entry;
+    }
+
+    if (entry->hash == hash) {
+      if (entry->key == key || $((Object *) entry->key, isEqual, key)) {
+        return entry;
+      }
+    }
+  }
+}
+
+/**
+ * @return The 64-bit hash of a String key with the given characters, as `hashForKey` computes it.
+ */
+static inline size_t hashForCharacters(const char *chars, size_t length) {
+
+  const uint64_t seed = Hash64Seed();
+
+  return Hash64ForInteger(seed, (uint32_t) (int) Hash64ForBytes(seed, chars, length));
+}
+
+/**
+ * @return The entry for the String key with the given characters, or the vacant entry at which it
+ * would be inserted.
+ * @remarks The table must not be empty, nor full.
+ */
+static DictionaryEntry *entryForCharacters(const Dictionary *self, const char *chars, size_t length, size_t hash) {
+
+  const size_t mask = self->capacity - 1;
+
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+
+    DictionaryEntry *entry = self->elements + i;
+    if (entry->key == NULL) {
+      return entry;
+    }
+
+    if (entry->hash == hash && $((Object *) entry->key, isKindOfClass, _String())) {
+      const String *key = entry->key;
+      if (key->length == length && memcmp(key->chars, chars, length) == 0) {
+        return entry;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Vacates `entry`, shifting back any entries that probed past it, so that no tombstone is
+ * left behind.
+ */
+static void vacate(Dictionary *self, DictionaryEntry *entry) {
+
+  const size_t mask = self->capacity - 1;
+
+  size_t i = entry - self->elements;
+
+  for (size_t j = (i + 1) & mask; self->elements[j].key; j = (j + 1) & mask) {
+
+    const size_t k = self->elements[j].hash & mask;
+    if (((j - k) & mask) >= ((j - i) & mask)) {
+      self->elements[i] = self->elements[j];
+      i = j;
+    }
+  }
+
+  self->elements[i] = (DictionaryEntry) { .key = NULL };
+}
+
+/**
+ * @brief Shares the entries of `dictionary` with `self`, which must have none of its own.
+ */
+static void share(Dictionary *self, const Dictionary *dictionary) {
+
+  if (dictionary->count == 0) {
+    return;
+  }
+
+  /* Copying is not a mutation, so two threads may copy the same Dictionary at once. */
+  size_t *references = __atomic_load_n(&((Dictionary *) dictionary)->references, __ATOMIC_ACQUIRE);
+  if (references == NULL) {
+
+    size_t *owner = malloc(sizeof(size_t));
+    assert(owner);
+
+    *owner = 1;
+
+    if (__atomic_compare_exchange_n(&((Dictionary *) dictionary)->references, &references, owner, 0,
+        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      references = owner;
+    } else {
+      free(owner);
+    }
+  }
+
+  __atomic_add_fetch(references, 1, __ATOMIC_RELAXED);
+
+  self->elements = dictionary->elements;
+  self->capacity = dictionary->capacity;
+  self->count = dictionary->count;
+  self->references = references;
+}
+
+/**
+ * @brief Relinquishes this Dictionary's entries, releasing them if no other Dictionary shares them.
+ */
+static void relinquish(Dictionary *self) {
+
+  if (self->references == NULL || __atomic_sub_fetch(self->references, 1, __ATOMIC_ACQ_REL) == 0) {
+
+    for (size_t i = 0; i < self->capacity; i++) {
+      if (self->elements[i].key) {
+        release(self->elements[i].key);
+        release(self->elements[i].obj);
+      }
+    }
+
+    free(self->elements);
+    free(self->references);
+  }
+
+  self->elements = NULL;
+  self->references = NULL;
+}
+
+/**
+ * @brief Ensures that this Dictionary owns its entries outright, before it is mutated.
+ */
+static void unshare(Dictionary *self) {
+
+  size_t *references = self->references;
+  if (references) {
+
+    if (__atomic_load_n(references, __ATOMIC_ACQUIRE) > 1) {
+
+      DictionaryEntry *elements = malloc(self->capacity * sizeof(DictionaryEntry));
+      assert(elements);
+
+      memcpy(elements, self->elements, self->capacity * sizeof(DictionaryEntry));
+
+      for (size_t i = 0; i < self->capacity; i++) {
+        if (elements[i].key) {
+          retain(elements[i].key);
+          retain(elements[i].obj);
+        }
+      }
+
+      /* Every other Dictionary may have let go while these were retained. */
+      relinquish(self);
+
+      self->elements = elements;
+    } else {
+      free(references);
+      self->references = NULL;
+    }
+  }
+}
+
 #pragma mark - Object
 
 /**
@@ -45,10 +222,7 @@ static Object *copy(const Object *self) {
 
   const Dictionary *this = (const Dictionary *) self;
 
-  Dictionary *that = $(alloc(Dictionary), initWithCapacity, this->capacity);
-  if (that) {
-    $(that, addEntriesFromDictionary, this);
-  }
+  Dictionary *that = $(alloc(Dictionary), initWithDictionary, this);
 
   return (Object *) that;
 }
@@ -58,13 +232,7 @@ static Object *copy(const Object *self) {
  */
 static void dealloc(Object *self) {
 
-  Dictionary *this = (Dictionary *) self;
-
-  for (size_t i = 0; i < this->capacity; i++) {
-    release(this->elements[i]);
-  }
-
-  free(this->elements);
+  relinquish((Dictionary *) self);
 
   super(Object, self, dealloc);
 }
@@ -74,15 +242,12 @@ static void dealloc(Object *self) {
  */
 static void description_enumerator(const Dictionary *dict, ident obj, ident key, ident data) {
 
-  String *desc = (String *) data;
+  StringBuilder *builder = (StringBuilder *) data;
 
-  String *objDesc = $((Object *) obj, description);
-  String *keyDesc = $((Object *) key, description);
-
-  $(desc, appendFormat, "%s: %s, ", keyDesc->chars, objDesc->chars);
-
-  release(objDesc);
-  release(keyDesc);
+  $(builder, appendDescription, key);
+  $(builder, appendCharacters, ": ");
+  $(builder, appendDescription, obj);
+  $(builder, appendCharacters, ", ");
 }
 
 /**
@@ -92,15 +257,19 @@ static String *description(const Object *self) {
 
   const Dictionary *this = (Dictionary *) self;
 
-  String *desc = $(alloc(String), init);
+  StringBuilder *builder = $(alloc(StringBuilder), init);
+
+  $(builder, appendCharacters, "{");
 
-  $(desc, appendCharacters, "{");
+  $(this, enumerateObjectsAndKeys, description_enumerator, builder);
 
-  $(this, enumerateObjectsAndKeys, description_enumerator, desc);
+  $(builder, appendCharacters, "}");
 
-  $(desc, appendCharacters, "}");
+  String *desc = $(builder, string);
 
-  return (String *) desc;
+  release(builder);
+
+  return desc;
 }
 
 /**
@@ -110,15 +279,18 @@ static int hash(const Object *self) {
 
   const Dictionary *this = (Dictionary *) self;
 
-  int hash = HashForInteger(HASH_SEED, this->count);
+  const uint64_t seed = Hash64Seed();
+
+  uint64_t hash = 0;
 
   for (size_t i = 0; i < this->capacity; i++) {
-    if (this->elements[i]) {
-      hash = HashForObject(hash, this->elements[i]);
+    const DictionaryEntry *entry = &this->elements[i];
+    if (entry->key) {
+      hash += Hash64Combine(entry->hash, Hash64ForObject(seed, entry->obj));
     }
   }
 
-  return hash;
+  return (int) Hash64Combine(hash, this->count);
 }
 
 /**
@@ -299,16 +471,9 @@ static void enumerateObjectsAndKeys(const Dictionary *self, DictionaryEnumerator
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
-
-      for (size_t j = 0; j < array->count; j += 2) {
-
-        ident key = $(array, objectAtIndex, j);
-        ident obj = $(array, objectAtIndex, j + 1);
-
-        enumerator(self, obj, key, data);
-      }
+    const DictionaryEntry *entry = self->elements + i;
+    if (entry->key) {
+      enumerator(self, entry->obj, entry->key, data);
     }
   }
 }
@@ -325,17 +490,10 @@ static Dictionary *filterObjectsAndKeys(const Dictionary *self, DictionaryPredic
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
-
-      for (size_t j = 0; j < array->count; j += 2) {
-
-        ident key = $(array, objectAtIndex, j);
-        ident obj = $(array, objectAtIndex, j + 1);
-
-        if (predicate(obj, key, data)) {
-          $(dictionary, setObjectForKey, obj, key);
-        }
+    const DictionaryEntry *entry = self->elements + i;
+    if (entry->key) {
+      if (predicate(entry->obj, entry->key, data)) {
+        $(dictionary, setObjectForKey, entry->obj, entry->key);
       }
     }
   }
@@ -361,10 +519,14 @@ static Dictionary *initWithCapacity(Dictionary *self, size_t capacity) {
   self = (Dictionary *) super(Object, self, init);
   if (self) {
 
-    self->capacity = capacity;
-    if (self->capacity) {
+    if (capacity) {
+
+      self->capacity = 1;
+      while (self->capacity < capacity) {
+        self->capacity <<= 1;
+      }
 
-      self->elements = calloc(self->capacity, sizeof(ident));
+      self->elements = calloc(self->capacity, sizeof(DictionaryEntry));
       assert(self->elements);
     }
   }
@@ -381,21 +543,7 @@ static Dictionary *initWithDictionary(Dictionary *self, const Dictionary *dictio
   self = (Dictionary *) super(Object, self, init);
   if (self) {
     if (dictionary) {
-
-      self->capacity = dictionary->capacity;
-
-      self->elements = calloc(self->capacity, sizeof(ident));
-      assert(self->elements);
-
-      for (size_t i = 0; i < dictionary->capacity; i++) {
-
-        Array *array = dictionary->elements[i];
-        if (array) {
-          self->elements[i] = $((Object *) array, copy);
-        }
-      }
-
-      self->count = dictionary->count;
+      share(self, dictionary);
     }
   }
 
@@ -438,22 +586,11 @@ static Dictionary *initWithObjectsAndKeys(Dictionary *self, ...) {
  */
 static ident objectForKey(const Dictionary *self, const ident key) {
 
-  if (self->capacity == 0) {
+  if (self->count == 0) {
     return NULL;
   }
-  
-  const size_t bin = HashForObject(HASH_SEED, key) % self->capacity;
-
-  Array *array = self->elements[bin];
-  if (array) {
-
-    const ssize_t index = $(array, indexOfObject, key);
-    if (index > -1 && (index & 1) == 0) {
-      return $(array, objectAtIndex, index + 1);
-    }
-  }
 
-  return NULL;
+  return entryForKey(self, key, hashForKey(key))->obj;
 }
 
 /**
@@ -464,13 +601,7 @@ static ident objectForKeyPath(const Dictionary *self, const char *path) {
 
   assert(path);
 
-  String *key = str(path);
-
-  ident obj = $(self, objectForKey, key);
-
-  release(key);
-
-  return obj;
+  return $(self, objectForKeyWithCharacters, path, strlen(path));
 }
 
 /**
@@ -493,17 +624,46 @@ static ident objectForKeyPathWithClass(const Dictionary *self, const char *path,
   return NULL;
 }
 
+/**
+ * @fn ident Dictionary::objectForKeyWithCharacters(const Dictionary *self, const char *chars, size_t length)
+ * @memberof Dictionary
+ */
+static ident objectForKeyWithCharacters(const Dictionary *self, const char *chars, size_t length) {
+
+  if (self->count == 0) {
+    return NULL;
+  }
+
+  return entryForCharacters(self, chars, length, hashForCharacters(chars, length))->obj;
+}
+
 /**
  * @fn void Dictionary::removeAllObjects(Dictionary *self)
  * @memberof Dictionary
  */
 static void removeAllObjects(Dictionary *self) {
 
+  if (self->references) {
+
+    const size_t capacity = self->capacity;
+
+    relinquish(self);
+
+    self->elements = calloc(capacity, sizeof(DictionaryEntry));
+    assert(self->elements);
+
+    self->count = 0;
+    return;
+  }
+
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
-      self->elements[i] = release(array);
+    DictionaryEntry *entry = self->elements + i;
+    if (entry->key) {
+      release(entry->key);
+      release(entry->obj);
+
+      *entry = (DictionaryEntry) { .key = NULL };
     }
   }
 
@@ -518,26 +678,40 @@ static void removeAllObjectsWithEnumerator(Dictionary *self, DictionaryEnumerato
 
   assert(enumerator);
 
-  for (size_t i = 0; i < self->capacity; i++) {
+  unshare(self);
 
-    Array *array = self->elements[i];
-    if (array) {
-      for (size_t j = array->count; j > 0; j -= 2) {
+  for (size_t i = 0; i < self->capacity && self->count; i++) {
 
-        ident obj = array->elements[j - 1];
-        ident key = array->elements[j - 2];
+    DictionaryEntry *entry = self->elements + i;
+    if (entry->key) {
 
-        enumerator(self, obj, key, data);
+      enumerator(self, entry->obj, entry->key, data);
 
-        $((Array *) array, removeObjectAtIndex, j - 1);
-        $((Array *) array, removeObjectAtIndex, j - 2);
-      }
+      release(entry->key);
+      release(entry->obj);
 
-      self->elements[i] = release(array);
+      *entry = (DictionaryEntry) { .key = NULL };
+      self->count--;
     }
   }
+}
 
-  self->count = 0;
+/**
+ * @brief Removes the pair at `entry`, if it is occupied.
+ */
+static void removeEntry(Dictionary *self, DictionaryEntry *entry) {
+
+  if (entry->key) {
+
+    ident key = entry->key, obj = entry->obj;
+
+    vacate(self, entry);
+
+    self->count--;
+
+    release(key);
+    release(obj);
+  }
 }
 
 /**
@@ -546,28 +720,13 @@ static void removeAllObjectsWithEnumerator(Dictionary *self, DictionaryEnumerato
  */
 static void removeObjectForKey(Dictionary *self, const ident key) {
 
-  if (self->capacity == 0) {
+  if (self->count == 0) {
     return;
   }
-  
-  const size_t bin = HashForObject(HASH_SEED, key) % self->capacity;
-
-  Array *array = self->elements[bin];
-  if (array) {
-
-    const ssize_t index = $((Array *) array, indexOfObject, key);
-    if (index > -1) {
 
-      $(array, removeObjectAtIndex, index);
-      $(array, removeObjectAtIndex, index);
+  unshare(self);
 
-      if (((Array *) array)->count == 0) {
-        self->elements[bin] = release(array);
-      }
-
-      self->count--;
-    }
-  }
+  removeEntry(self, entryForKey(self, key, hashForKey(key)));
 }
 
 /**
@@ -576,51 +735,84 @@ static void removeObjectForKey(Dictionary *self, const ident key) {
  */
 static void removeObjectForKeyPath(Dictionary *self, const char *path) {
 
-  String *key = $$(String, stringWithCharacters, path);
+  assert(path);
+
+  if (self->count == 0) {
+    return;
+  }
+
+  unshare(self);
 
-  $(self, removeObjectForKey, key);
+  const size_t length = strlen(path);
 
-  release(key);
+  removeEntry(self, entryForCharacters(self, path, length, hashForCharacters(path, length)));
 }
 
 /**
  * @brief A helper for resizing Dictionaries as pairs are added to them.
- * @remarks Static method invocations are used for all operations.
+ * @details The table is doubled in place: every entry it held is marked pending, and then moved to
+ * its new position using its cached hash. An entry that lands on one still pending displaces it,
+ * and that one is placed next. Neither `hash` nor `isEqual` is invoked.
  */
 static void setObjectForKey_resize(Dictionary *dict) {
 
   if (dict->capacity) {
 
-    const float load = dict->count / (float) dict->capacity;
-    if (load >= DICTIONARY_MAX_LOAD) {
+    const float load = (dict->count + 1) / (float) dict->capacity;
+    if (load > DICTIONARY_MAX_LOAD) {
 
-      size_t capacity = dict->capacity;
-      ident *elements = dict->elements;
+      const size_t capacity = dict->capacity;
 
-      dict->capacity = dict->capacity * DICTIONARY_GROW_FACTOR;
-      dict->count = 0;
+      dict->capacity = capacity << 1;
 
-      dict->elements = calloc(dict->capacity, sizeof(ident));
+      dict->elements = realloc(dict->elements, dict->capacity * sizeof(DictionaryEntry));
       assert(dict->elements);
 
+      memset(dict->elements + capacity, 0, capacity * sizeof(DictionaryEntry));
+
+      bool *pending = calloc(capacity, sizeof(bool));
+      assert(pending);
+
       for (size_t i = 0; i < capacity; i++) {
+        pending[i] = dict->elements[i].key != NULL;
+      }
 
-        Array *array = elements[i];
-        if (array) {
+      const size_t mask = dict->capacity - 1;
 
-          for (size_t j = 0; j < array->count; j += 2) {
+      for (size_t i = 0; i < capacity; i++) {
+        if (pending[i]) {
 
-            ident key = $(array, objectAtIndex, j);
-            ident obj = $(array, objectAtIndex, j + 1);
+          DictionaryEntry entry = dict->elements[i];
 
-            $$(Dictionary, setObjectForKey, dict, obj, key);
-          }
+          dict->elements[i] = (DictionaryEntry) { .key = NULL };
+          pending[i] = false;
+
+          size_t j = entry.hash & mask;
+          while (true) {
+
+            DictionaryEntry *e = dict->elements + j;
+            if (e->key == NULL) {
+              *e = entry;
+              break;
+            }
+
+            if (j < capacity && pending[j]) {
+              const DictionaryEntry displaced = *e;
 
-          release(array);
+              *e = entry;
+              pending[j] = false;
+
+              entry = displaced;
+              j = entry.hash & mask;
+              continue;
+            }
+
+            j = (j + 1) & mask;
+          }
         }
       }
 
-      free(elements);
+      free(pending);
     }
   } else {
     $(dict, initWithCapacity, DICTIONARY_DEFAULT_CAPACITY);
@@ -633,25 +825,31 @@ static void setObjectForKey_resize(Dictionary *dict) {
  */
 static void setObjectForKey(Dictionary *self, const ident obj, const ident key) {
 
-  Dictionary *dict = self;
+  assert(key);
 
-  setObjectForKey_resize(dict);
+  unshare(self);
 
-  const size_t bin = HashForObject(HASH_SEED, key) % dict->capacity;
+  setObjectForKey_resize(self);
 
-  Array *array = dict->elements[bin];
-  if (array == NULL) {
-    array = dict->elements[bin] = $$(Array, arrayWithCapacity, (dict->capacity >> 2) + 1);
-  }
+  const size_t hash = hashForKey(key);
+
+  DictionaryEntry *entry = entryForKey(self, key, hash);
+  if (entry->key) {
+
+    retain(obj);
 
-  const ssize_t index = $((Array *) array, indexOfObject, key);
-  if (index > -1 && (index & 1) == 0) {
-    $(array, setObjectAtIndex, obj, index + 1);
+    release(entry->obj);
+
+    entry->obj = obj;
   } else {
-    $(array, addObject, key);
-    $(array, addObject, obj);
 
-    dict->count++;
+    *entry = (DictionaryEntry) {
+      .key = retain(key),
+      .obj = retain(obj),
+      .hash = hash
+    };
+
+    self->count++;
   }
 }
 
@@ -661,11 +859,33 @@ static void setObjectForKey(Dictionary *self, const ident obj, const ident key)
  */
 static void setObjectForKeyPath(Dictionary *self, const ident obj, const char *path) {
 
-  String *key = $$(String, stringWithCharacters, path);
+  assert(path);
+
+  unshare(self);
+
+  setObjectForKey_resize(self);
+
+  const size_t length = strlen(path);
+  const size_t hash = hashForCharacters(path, length);
 
-  $(self, setObjectForKey, obj, key);
+  DictionaryEntry *entry = entryForCharacters(self, path, length, hash);
+  if (entry->key) {
 
-  release(key);
+    retain(obj);
+
+    release(entry->obj);
+
+    entry->obj = obj;
+  } else {
+
+    *entry = (DictionaryEntry) {
+      .key = $$(String, stringWithCharacters, path),
+      .obj = retain(obj),
+      .hash = hash
+    };
+
+    self->count++;
+  }
 }
 
 /**
@@ -745,6 +965,7 @@ static void initialize(Class *clazz) {
   ((DictionaryInterface *) clazz->interface)->objectForKey = objectForKey;
   ((DictionaryInterface *) clazz->interface)->objectForKeyPath = objectForKeyPath;
   ((DictionaryInterface *) clazz->interface)->objectForKeyPathWithClass = objectForKeyPathWithClass;
+  ((DictionaryInterface *) clazz->interface)->objectForKeyWithCharacters = objectForKeyWithCharacters;
   ((DictionaryInterface *) clazz->interface)->removeAllObjects = removeAllObjects;
   ((DictionaryInterface *) clazz->interface)->removeAllObjectsWithEnumerator = removeAllObjectsWithEnumerator;
   ((DictionaryInterface *) clazz->interface)->removeObjectForKey = removeObjectForKey;
@@ -52,8 +52,30 @@ typedef void (*DictionaryEnumerator)(const Dictionary *dictionary, ident obj, id
  */
 typedef bool (*DictionaryPredicate)(ident obj, ident key, ident data);
 
+/**
+ * @brief A key-value pair, and the hash of its key.
+ */
+typedef struct {
+
+  /**
+   * @brief The key, or `NULL` if this entry is vacant.
+   */
+  ident key;
+
+  /**
+   * @brief The Object.
+   */
+  ident obj;
+
+  /**
+   * @brief The finalized hash of `key`, so that probing and growing need not recompute it.
+   */
+  size_t hash;
+} DictionaryEntry;
+
 /**
  * @brief Key-value stores.
+ * @details Entries are stored inline in a single open-addressed table, probed linearly.
  * @extends Object
  * @ingroup Collections
  */
@@ -71,7 +93,7 @@ struct Dictionary {
   DictionaryInterface *interface;
 
   /**
-   * @brief The internal size (number of bins).
+   * @brief The internal size (number of entries), always a power of two.
    * @private
    */
   size_t capacity;
@@ -82,10 +104,18 @@ struct Dictionary {
   size_t count;
 
   /**
-   * @brief The elements.
+   * @brief The entries.
+   * @private
+   */
+  DictionaryEntry *elements;
+
+  /**
+   * @brief The number of Dictionaries sharing `elements`, or `NULL` if this Dictionary owns
+   * them outright.
+   * @details Copies share their elements until either is mutated, which then copies them.
    * @private
    */
-  ident *elements;
+  size_t *references;
 };
 
 
@@ -216,7 +246,7 @@ struct DictionaryInterface {
    * @fn Dictionary *Dictionary::initWithCapacity(Dictionary *self, size_t capacity)
    * @brief Initializes this Dictionary with the specified capacity.
    * @param self The Dictionary.
-   * @param capacity The initial capacity.
+   * @param capacity The initial capacity, which is rounded up to a power of two.
    * @return The initialized Dictionary, or `NULL` on error.
    * @memberof Dictionary
    */
@@ -271,6 +301,18 @@ struct DictionaryInterface {
    */
   ident (*objectForKeyPathWithClass)(const Dictionary *self, const char *path, const Class *clazz);
 
+  /**
+   * @fn ident Dictionary::objectForKeyWithCharacters(const Dictionary *self, const char *chars, size_t length)
+   * @param self The Dictionary.
+   * @param chars The UTF-8 encoded characters of a String key, which need not be null-terminated.
+   * @param length The length of `chars`, in bytes.
+   * @return The Object stored at the String key with the given characters, or `NULL`.
+   * @remarks Equivalent to `objectForKey` with a String key, but without creating one. The
+   * characters are hashed as `String::hash` hashes them, and compared directly.
+   * @memberof Dictionary
+   */
+  ident (*objectForKeyWithCharacters)(const Dictionary *self, const char *chars, size_t length);
+
   /**
    * @fn void Dictionary::removeAllObjects(Dictionary *self)
    * @brief Removes all Objects from this Dictionary.
@@ -21,7 +21,10 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include "Hash.h"
 
@@ -79,3 +82,190 @@ int HashForObject(int hash, const ident obj) {
 
   return 0;
 }
+
+#pragma mark - 64-bit
+
+/**
+ * @brief The wyhash secret (final version 4).
+ */
+static const uint64_t secret[] = {
+  0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+/**
+ * @brief Multiplies `a` and `b`, leaving the low 64 bits of the product in `a`, and the high in `b`.
+ */
+static void mum(uint64_t *a, uint64_t *b) {
+
+#if defined(__SIZEOF_INT128__)
+  const __uint128_t r = (__uint128_t) *a * *b;
+
+  *a = (uint64_t) r;
+  *b = (uint64_t) (r >> 64);
+#else
+  const uint64_t ha = *a >> 32, hb = *b >> 32, la = (uint32_t) *a, lb = (uint32_t) *b;
+  const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+
+  const uint64_t t = rl + (rm0 << 32);
+  uint64_t carry = t < rl;
+
+  const uint64_t lo = t + (rm1 << 32);
+  carry += lo < t;
+
+  *a = lo;
+  *b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+/**
+ * @return The folded product of `a` and `b`.
+ */
+static uint64_t mix(uint64_t a, uint64_t b) {
+  mum(&a, &b);
+  return a ^ b;
+}
+
+/**
+ * @return The 8 bytes at `p`.
+ */
+static uint64_t read8(const uint8_t *p) {
+  uint64_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ * @return The 4 bytes at `p`.
+ */
+static uint64_t read4(const uint8_t *p) {
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ * @return Up to 3 bytes at `p`, of `k`.
+ */
+static uint64_t read3(const uint8_t *p, size_t k) {
+  return (((uint64_t) p[0]) << 16) | (((uint64_t) p[k >> 1]) << 8) | p[k - 1];
+}
+
+/**
+ * @return A seed from the system's entropy source, or the clock and address space if it has none.
+ */
+static uint64_t randomSeed(void) {
+
+  uint64_t seed = 0;
+
+  FILE *file = fopen("/dev/urandom", "rb");
+  if (file) {
+    if (fread(&seed, sizeof(seed), 1, file) != 1) {
+      seed = 0;
+    }
+    fclose(file);
+  }
+
+  if (seed == 0) {
+    seed = mix((uint64_t) time(NULL) ^ secret[0], (uint64_t) (uintptr_t) &seed ^ secret[1]);
+    seed = mix(seed ^ (uint64_t) clock(), (uint64_t) (uintptr_t) randomSeed ^ secret[2]);
+  }
+
+  return seed;
+}
+
+static uint64_t _seed;
+
+uint64_t Hash64Seed(void) {
+  static Once once;
+
+  do_once(&once, {
+    const char *env = getenv("OBJECTIVELY_HASH_SEED");
+    if (env && *env) {
+      _seed = strtoull(env, NULL, 0);
+    } else {
+      _seed = randomSeed();
+    }
+  });
+
+  return _seed;
+}
+
+uint64_t Hash64ForBytes(uint64_t seed, const void *bytes, size_t length) {
+
+  const uint8_t *p = bytes;
+  uint64_t a, b;
+
+  seed ^= mix(seed ^ secret[0], secret[1]);
+
+  if (length <= 16) {
+    if (length >= 4) {
+      a = (read4(p) << 32) | read4(p + ((length >> 3) << 2));
+      b = (read4(p + length - 4) << 32) | read4(p + length - 4 - ((length >> 3) << 2));
+    } else if (length > 0) {
+      a = read3(p, length);
+      b = 0;
+    } else {
+      a = b = 0;
+    }
+  } else {
+    size_t i = length;
+    if (i >= 48) {
+      uint64_t see1 = seed, see2 = seed;
+      do {
+        seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+        see1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ see1);
+        see2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ see2);
+        p += 48;
+        i -= 48;
+      } while (i >= 48);
+      seed ^= see1 ^ see2;
+    }
+
+    while (i > 16) {
+      seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+
+  a ^= secret[1];
+  b ^= seed;
+
+  mum(&a, &b);
+
+  return mix(a ^ secret[0] ^ length, b ^ secret[1]);
+}
+
+uint64_t Hash64ForCString(uint64_t seed, const char *chars) {
+
+  if (chars) {
+    return Hash64ForBytes(seed, chars, strlen(chars));
+  }
+
+  return Hash64ForInteger(seed, 0);
+}
+
+uint64_t Hash64ForInteger(uint64_t seed, uint64_t integer) {
+
+  uint64_t a = integer ^ secret[0], b = seed ^ secret[1];
+
+  mum(&a, &b);
+
+  return mix(a ^ secret[2], b ^ secret[3]);
+}
+
+uint64_t Hash64ForObject(uint64_t seed, const ident obj) {
+
+  if (obj) {
+    return Hash64ForInteger(seed, (uint32_t) $(cast(Object, obj), hash));
+  }
+
+  return Hash64ForInteger(seed, 0);
+}
+
+uint64_t Hash64Combine(uint64_t hash, uint64_t value) {
+  return mix(hash ^ secret[0], value ^ secret[3]);
+}
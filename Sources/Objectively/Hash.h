@@ -85,3 +85,55 @@ OBJECTIVELY_EXPORT int HashForInteger(int hash, const long integer);
  * @return The accumulated hash value.
  */
 OBJECTIVELY_EXPORT int HashForObject(int hash, const ident obj);
+
+/**
+ * @return The seed for the 64-bit hash functions, chosen at random once per process.
+ * @remarks Set the environment variable `OBJECTIVELY_HASH_SEED` to an integer to fix it instead,
+ * e.g. to reproduce the iteration order of a Dictionary or Set from one run to the next.
+ */
+OBJECTIVELY_EXPORT uint64_t Hash64Seed(void);
+
+/**
+ * @brief Calculates the 64-bit hash value of `bytes`.
+ * @param seed The seed, typically `Hash64Seed()`.
+ * @param bytes The bytes to hash.
+ * @param length The number of bytes to hash.
+ * @return The hash value.
+ * @remarks This is wyhash, which consumes its input a word at a time. Unlike the `HashFor`
+ * functions, each bit of the result depends on every bit of the input, so tables may index by
+ * masking it.
+ */
+OBJECTIVELY_EXPORT uint64_t Hash64ForBytes(uint64_t seed, const void *bytes, size_t length);
+
+/**
+ * @brief Calculates the 64-bit hash value of the null-terminated `chars`.
+ * @param seed The seed, typically `Hash64Seed()`.
+ * @param chars The null-terminated C string.
+ * @return The hash value.
+ */
+OBJECTIVELY_EXPORT uint64_t Hash64ForCString(uint64_t seed, const char *chars);
+
+/**
+ * @brief Calculates the 64-bit hash value of `integer`.
+ * @param seed The seed, typically `Hash64Seed()`.
+ * @param integer The integer to hash.
+ * @return The hash value.
+ */
+OBJECTIVELY_EXPORT uint64_t Hash64ForInteger(uint64_t seed, uint64_t integer);
+
+/**
+ * @brief Calculates the 64-bit hash value of `obj`, from its `Object::hash`.
+ * @param seed The seed, typically `Hash64Seed()`.
+ * @param obj The Object to hash, or `NULL`.
+ * @return The hash value.
+ */
+OBJECTIVELY_EXPORT uint64_t Hash64ForObject(uint64_t seed, const ident obj);
+
+/**
+ * @brief Combines `value` into `hash`, such that the order of combination matters.
+ * @param hash The hash accumulator.
+ * @param value The 64-bit hash value to combine.
+ * @return The combined hash value.
+ * @remarks Unordered collections should instead sum the hash values of their members.
+ */
+OBJECTIVELY_EXPORT uint64_t Hash64Combine(uint64_t hash, uint64_t value);
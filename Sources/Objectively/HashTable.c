@@ -28,14 +28,45 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include "Hash.h"
 #include "HashTable.h"
 
 #define _Class _HashTable
 
+/**
+ * @brief The number of slots whose control bytes are matched at once. Capacity is always a power
+ * of two, and a multiple of this.
+ */
+#define HASHTABLE_GROUP 16
+
 #define HASHTABLE_DEFAULT_CAPACITY 16
-#define HASHTABLE_GROW_FACTOR 2
-#define HASHTABLE_MAX_LOAD 0.75f
+
+/**
+ * @brief The control byte of a slot that holds no entry. Probes stop at any group with one.
+ */
+#define HASHTABLE_EMPTY 0x80
+
+/**
+ * @brief The control byte of a slot whose entry was removed. Probes pass over deleted slots, and
+ * insertions reuse them.
+ */
+#define HASHTABLE_DELETED 0xfe
+
+/**
+ * @brief Matches yield one bit per slot, or, with NEON, one nibble per slot narrowed to its high
+ * bit. Either way, the offset of a slot is its bit index shifted right by this.
+ */
+#if defined(__ARM_NEON) && defined(__aarch64__) && !defined(__SSE2__)
+#define HASHTABLE_MATCH_SHIFT 2
+#else
+#define HASHTABLE_MATCH_SHIFT 0
+#endif
 
 #pragma mark - Built-in hash/equal functions
 
@@ -43,13 +74,7 @@
  * @see HashTableHashStr
  */
 size_t HashTableHashStr(const ident key) {
-  const char *s = (const char *) key;
-  size_t h = 5381;
-  int c;
-  while ((c = *s++)) {
-    h = ((h << 5) + h) + (size_t) c;
-  }
-  return h;
+  return (size_t) Hash64ForCString(Hash64Seed(), (const char *) key);
 }
 
 /**
@@ -63,13 +88,25 @@ bool HashTableEqualStr(const ident a, const ident b) {
  * @see HashTableHashStri
  */
 size_t HashTableHashStri(const ident key) {
+
   const char *s = (const char *) key;
-  size_t h = 5381;
-  int c;
-  while ((c = *s++)) {
-    h = ((h << 5) + h) + (size_t) tolower(c);
+  const size_t length = strlen(s);
+
+  char buffer[128];
+  char *lower = length <= sizeof(buffer) ? buffer : malloc(length);
+  assert(lower);
+
+  for (size_t i = 0; i < length; i++) {
+    lower[i] = (char) tolower((unsigned char) s[i]);
+  }
+
+  const size_t hash = (size_t) Hash64ForBytes(Hash64Seed(), lower, length);
+
+  if (lower != buffer) {
+    free(lower);
   }
-  return h;
+
+  return hash;
 }
 
 /**
@@ -83,7 +120,7 @@ bool HashTableEqualStri(const ident a, const ident b) {
  * @see HashTableHashDirect
  */
 size_t HashTableHashDirect(const ident key) {
-  return (size_t) (uintptr_t) key;
+  return (size_t) Hash64ForInteger(Hash64Seed(), (uintptr_t) key);
 }
 
 /**
@@ -93,6 +130,169 @@ bool HashTableEqualDirect(const ident a, const ident b) {
   return a == b;
 }
 
+#pragma mark - Probing
+
+/**
+ * @brief Mixes `hash`, so that its low bits, which select a group, depend on all of its bits.
+ */
+static inline size_t mix(size_t hash) {
+  const uint64_t h = (uint64_t) hash * 0x9e3779b97f4a7c15ull;
+  return (size_t) (h ^ (h >> 32));
+}
+
+/**
+ * @return The control byte for a slot holding a key of the given (mixed) hash.
+ */
+static inline uint8_t tag(size_t hash) {
+  return hash & 0x7f;
+}
+
+/**
+ * @return A mask of the slots in the group at `controls` whose control byte is `byte`.
+ */
+static inline uint64_t match(const uint8_t *controls, uint8_t byte) {
+
+#if defined(__SSE2__)
+  const __m128i group = _mm_loadu_si128((const __m128i *) controls);
+  return (uint64_t) _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char) byte)));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t eq = vceqq_u8(vld1q_u8(controls), vdupq_n_u8(byte));
+  const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+  return mask & 0x8888888888888888ull;
+#else
+  uint64_t mask = 0;
+  for (size_t i = 0; i < HASHTABLE_GROUP; i++) {
+    mask |= (uint64_t) (controls[i] == byte) << i;
+  }
+  return mask;
+#endif
+}
+
+/**
+ * @return A mask of the slots in the group at `controls` that are empty or deleted.
+ */
+static inline uint64_t matchAvailable(const uint8_t *controls) {
+
+#if defined(__SSE2__)
+  return (uint64_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i *) controls));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t available = vcgeq_u8(vld1q_u8(controls), vdupq_n_u8(HASHTABLE_EMPTY));
+  const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(available), 4)), 0);
+  return mask & 0x8888888888888888ull;
+#else
+  uint64_t mask = 0;
+  for (size_t i = 0; i < HASHTABLE_GROUP; i++) {
+    mask |= (uint64_t) (controls[i] >> 7) << i;
+  }
+  return mask;
+#endif
+}
+
+/**
+ * @return The offset within its group of the first slot in the nonzero `mask`.
+ */
+static inline size_t first(uint64_t mask) {
+  return __builtin_ctzll(mask) >> HASHTABLE_MATCH_SHIFT;
+}
+
+/**
+ * @return The slot holding `key`, or `-1` if this HashTable does not contain it.
+ * @remarks Groups are probed triangularly, which, for a power of two number of groups, visits
+ * each of them once.
+ */
+static ssize_t find(const HashTable *self, const ident key, size_t hash) {
+
+  const size_t groups = self->capacity / HASHTABLE_GROUP - 1;
+  size_t group = (hash >> 7) & groups;
+
+  for (size_t probe = 1; probe <= groups + 1; probe++) {
+
+    const uint8_t *controls = self->controls + group * HASHTABLE_GROUP;
+
+    for (uint64_t mask = match(controls, tag(hash)); mask; mask &= mask - 1) {
+      const size_t slot = group * HASHTABLE_GROUP + first(mask);
+      if (self->equal(self->entries[slot].key, key)) {
+        return slot;
+      }
+    }
+
+    if (match(controls, HASHTABLE_EMPTY)) {
+      break;
+    }
+
+    group = (group + probe) & groups;
+  }
+
+  return -1;
+}
+
+/**
+ * @return The first empty or deleted slot along the probe sequence for `hash`.
+ */
+static size_t findAvailable(const HashTable *self, size_t hash) {
+
+  const size_t groups = self->capacity / HASHTABLE_GROUP - 1;
+  size_t group = (hash >> 7) & groups;
+
+  for (size_t probe = 1; ; probe++) {
+
+    const uint64_t mask = matchAvailable(self->controls + group * HASHTABLE_GROUP);
+    if (mask) {
+      return group * HASHTABLE_GROUP + first(mask);
+    }
+
+    group = (group + probe) & groups;
+  }
+}
+
+/**
+ * @brief Allocates `capacity` empty slots, and reinserts this HashTable's entries into them.
+ * @details Deleted slots are dropped along the way.
+ */
+static void resize(HashTable *self, size_t capacity) {
+
+  uint8_t *controls = self->controls;
+  HashTableEntry *entries = self->entries;
+  const size_t count = self->capacity;
+
+  self->controls = malloc(capacity);
+  assert(self->controls);
+
+  memset(self->controls, HASHTABLE_EMPTY, capacity);
+
+  self->entries = malloc(capacity * sizeof(HashTableEntry));
+  assert(self->entries);
+
+  self->capacity = capacity;
+  self->deleted = 0;
+
+  for (size_t i = 0; i < count; i++) {
+    if (controls[i] < HASHTABLE_EMPTY) {
+      const size_t hash = mix(self->hash(entries[i].key));
+      const size_t slot = findAvailable(self, hash);
+
+      self->controls[slot] = tag(hash);
+      self->entries[slot] = entries[i];
+    }
+  }
+
+  free(controls);
+  free(entries);
+}
+
+/**
+ * @brief Calls the destructors, if any, on the entry in `slot`.
+ */
+static inline void destroy(const HashTable *self, size_t slot) {
+
+  if (self->destroyKey) {
+    self->destroyKey(self->entries[slot].key);
+  }
+  if (self->destroyValue) {
+    self->destroyValue(self->entries[slot].value);
+  }
+}
+
 #pragma mark - Object
 
 /**
@@ -103,21 +303,13 @@ static void dealloc(Object *self) {
   HashTable *this = (HashTable *) self;
 
   for (size_t i = 0; i < this->capacity; i++) {
-    HashTableEntry *e = this->buckets[i];
-    while (e) {
-      HashTableEntry *next = e->next;
-      if (this->destroyKey) {
-        this->destroyKey(e->key);
-      }
-      if (this->destroyValue) {
-        this->destroyValue(e->value);
-      }
-      free(e);
-      e = next;
+    if (this->controls[i] < HASHTABLE_EMPTY) {
+      destroy(this, i);
     }
   }
 
-  free(this->buckets);
+  free(this->controls);
+  free(this->entries);
 
   super(Object, self, dealloc);
 }
@@ -141,8 +333,8 @@ static void enumerate(const HashTable *self, HashTableEnumerator enumerator, ide
   assert(enumerator);
 
   for (size_t i = 0; i < self->capacity; i++) {
-    for (const HashTableEntry *e = self->buckets[i]; e; e = e->next) {
-      enumerator(self, e->key, e->value, data);
+    if (self->controls[i] < HASHTABLE_EMPTY) {
+      enumerator(self, self->entries[i].key, self->entries[i].value, data);
     }
   }
 }
@@ -153,15 +345,12 @@ static void enumerate(const HashTable *self, HashTableEnumerator enumerator, ide
  */
 static ident get(const HashTable *self, const ident key) {
 
-  const size_t bin = self->hash(key) % self->capacity;
-
-  for (const HashTableEntry *e = self->buckets[bin]; e; e = e->next) {
-    if (self->equal(e->key, key)) {
-      return e->value;
-    }
+  const ssize_t slot = find(self, key, mix(self->hash(key)));
+  if (slot == -1) {
+    return NULL;
   }
 
-  return NULL;
+  return self->entries[slot].value;
 }
 
 /**
@@ -186,9 +375,19 @@ static HashTable *initWithCapacity(HashTable *self, HashTableHashFunc hash, Hash
 
     self->hash = hash;
     self->equal = equal;
-    self->capacity = capacity;
-    self->buckets = calloc(self->capacity, sizeof(HashTableEntry *));
-    assert(self->buckets);
+
+    self->capacity = HASHTABLE_GROUP;
+    while (self->capacity < capacity) {
+      self->capacity <<= 1;
+    }
+
+    self->controls = malloc(self->capacity);
+    assert(self->controls);
+
+    memset(self->controls, HASHTABLE_EMPTY, self->capacity);
+
+    self->entries = malloc(self->capacity * sizeof(HashTableEntry));
+    assert(self->entries);
   }
   return self;
 }
@@ -199,25 +398,23 @@ static HashTable *initWithCapacity(HashTable *self, HashTableHashFunc hash, Hash
  */
 static void _remove(HashTable *self, const ident key) {
 
-  const size_t bin = self->hash(key) % self->capacity;
+  const ssize_t slot = find(self, key, mix(self->hash(key)));
+  if (slot == -1) {
+    return;
+  }
 
-  HashTableEntry **e = &self->buckets[bin];
-  while (*e) {
-    if (self->equal((*e)->key, key)) {
-      HashTableEntry *found = *e;
-      *e = found->next;
-      if (self->destroyKey) {
-        self->destroyKey(found->key);
-      }
-      if (self->destroyValue) {
-        self->destroyValue(found->value);
-      }
-      free(found);
-      self->count--;
-      return;
-    }
-    e = &(*e)->next;
+  destroy(self, slot);
+
+  /* A group with an empty slot ends every probe that reaches it, so no probe needs to pass over
+   * this one, and it can be emptied rather than deleted. */
+  if (match(self->controls + (slot & ~(size_t) (HASHTABLE_GROUP - 1)), HASHTABLE_EMPTY)) {
+    self->controls[slot] = HASHTABLE_EMPTY;
+  } else {
+    self->controls[slot] = HASHTABLE_DELETED;
+    self->deleted++;
   }
+
+  self->count--;
 }
 
 /**
@@ -227,45 +424,15 @@ static void _remove(HashTable *self, const ident key) {
 static void removeAll(HashTable *self) {
 
   for (size_t i = 0; i < self->capacity; i++) {
-    HashTableEntry *e = self->buckets[i];
-    while (e) {
-      HashTableEntry *next = e->next;
-      if (self->destroyKey) {
-        self->destroyKey(e->key);
-      }
-      if (self->destroyValue) {
-        self->destroyValue(e->value);
-      }
-      free(e);
-      e = next;
+    if (self->controls[i] < HASHTABLE_EMPTY) {
+      destroy(self, i);
     }
-    self->buckets[i] = NULL;
   }
 
-  self->count = 0;
-}
-
-/**
- * @brief Rehashes all entries into a new bucket array of the given capacity.
- */
-static void resize(HashTable *self, size_t capacity) {
-
-  HashTableEntry **buckets = calloc(capacity, sizeof(HashTableEntry *));
-  assert(buckets);
-
-  for (size_t i = 0; i < self->capacity; i++) {
-    for (HashTableEntry *e = self->buckets[i]; e; ) {
-      HashTableEntry *next = e->next;
-      const size_t bin = self->hash(e->key) % capacity;
-      e->next = buckets[bin];
-      buckets[bin] = e;
-      e = next;
-    }
-  }
+  memset(self->controls, HASHTABLE_EMPTY, self->capacity);
 
-  free(self->buckets);
-  self->buckets = buckets;
-  self->capacity = capacity;
+  self->count = 0;
+  self->deleted = 0;
 }
 
 /**
@@ -274,32 +441,33 @@ static void resize(HashTable *self, size_t capacity) {
  */
 static void set(HashTable *self, const ident key, const ident value) {
 
-  if ((float) self->count / (float) self->capacity >= HASHTABLE_MAX_LOAD) {
-    resize(self, self->capacity * HASHTABLE_GROW_FACTOR);
-  }
+  const size_t hash = mix(self->hash(key));
 
-  const size_t bin = self->hash(key) % self->capacity;
+  const ssize_t existing = find(self, key, hash);
+  if (existing != -1) {
+    destroy(self, existing);
 
-  for (HashTableEntry *e = self->buckets[bin]; e; e = e->next) {
-    if (self->equal(e->key, key)) {
-      if (self->destroyKey) {
-        self->destroyKey(e->key);
-      }
-      if (self->destroyValue) {
-        self->destroyValue(e->value);
-      }
-      e->key = key;
-      e->value = value;
-      return;
+    self->entries[existing] = (HashTableEntry) { .key = key, .value = value };
+    return;
+  }
+
+  /* Keep at least one slot in eight empty, so that probes for missing keys stay short. Deleted
+   * slots count against this, and are dropped in place if they alone would have the table grow. */
+  if (self->count + self->deleted + 1 > self->capacity - (self->capacity >> 3)) {
+    if (self->count + 1 <= (self->capacity >> 1) - (self->capacity >> 4)) {
+      resize(self, self->capacity);
+    } else {
+      resize(self, self->capacity << 1);
     }
   }
 
-  HashTableEntry *e = calloc(1, sizeof(HashTableEntry));
-  assert(e);
-  e->key = key;
-  e->value = value;
-  e->next = self->buckets[bin];
-  self->buckets[bin] = e;
+  const size_t slot = findAvailable(self, hash);
+  if (self->controls[slot] == HASHTABLE_DELETED) {
+    self->deleted--;
+  }
+
+  self->controls[slot] = tag(hash);
+  self->entries[slot] = (HashTableEntry) { .key = key, .value = value };
   self->count++;
 }
 
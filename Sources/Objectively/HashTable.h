@@ -54,6 +54,8 @@ typedef void (*HashTableEnumerator)(const HashTable *table, ident key, ident val
 
 /**
  * @brief Common hash functions for use with HashTable.
+ * @remarks The hash functions are seeded per process by `Hash64Seed`, so iteration order varies
+ * from one run to the next.
  */
 OBJECTIVELY_EXPORT size_t HashTableHashStr(const ident key);
 OBJECTIVELY_EXPORT bool   HashTableEqualStr(const ident a, const ident b);
@@ -63,17 +65,19 @@ OBJECTIVELY_EXPORT size_t HashTableHashDirect(const ident key);
 OBJECTIVELY_EXPORT bool   HashTableEqualDirect(const ident a, const ident b);
 
 /**
- * @brief Internal bucket entry.
+ * @brief Internal slot entry, stored inline.
  * @private
  */
 typedef struct HashTableEntry {
   ident key;
   ident value;
-  struct HashTableEntry *next;
 } HashTableEntry;
 
 /**
  * @brief Hash tables with user-supplied hash and equality functions.
+ * @details HashTable is open addressed. Each slot has a control byte, which is either empty,
+ * deleted, or 7 bits of the hash of the key it holds. Lookups match a group of 16 control bytes
+ * at once, with SSE2 or NEON where available, and compare keys only for slots whose bits match.
  * @extends Object
  * @ingroup Collections
  */
@@ -96,16 +100,28 @@ struct HashTable {
   size_t count;
 
   /**
-   * @brief The number of buckets.
+   * @brief The number of slots, a power of two.
    * @protected
    */
   size_t capacity;
 
   /**
-   * @brief The buckets.
-   * @protected
+   * @brief The number of slots whose entries were removed, but which probes must still pass over.
+   * @private
+   */
+  size_t deleted;
+
+  /**
+   * @brief The control bytes, one per slot.
+   * @private
+   */
+  uint8_t *controls;
+
+  /**
+   * @brief The entries, one per slot.
+   * @private
    */
-  HashTableEntry **buckets;
+  HashTableEntry *entries;
 
   /**
    * @brief The hash function.
@@ -183,7 +199,7 @@ struct HashTableInterface {
    * @param self The HashTable.
    * @param hash The hash function.
    * @param equal The equality function.
-   * @param capacity The initial bucket count.
+   * @param capacity The initial slot count, which is rounded up to a power of two of at least 16.
    * @return The initialized HashTable, or NULL on error.
    * @memberof HashTable
    */
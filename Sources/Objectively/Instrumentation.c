@@ -0,0 +1,338 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Config.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "Instrumentation.h"
+
+/**
+ * @brief The number of Classes each page of a Shard counts.
+ */
+#define INSTRUMENTATION_PAGE_SIZE 256
+
+/**
+ * @brief The number of pages in a Shard, which bounds the number of Classes counted.
+ */
+#define INSTRUMENTATION_PAGES 1024
+
+/**
+ * @brief The counters of one Class in one Shard. Written only by the thread that owns the
+ * Shard, and read by any.
+ */
+typedef struct {
+  size_t allocations;
+  size_t deallocations;
+  long pending;
+} Counters;
+
+typedef struct Shard Shard;
+
+/**
+ * @brief The counters of one thread at a time. A Shard is never freed: when its thread exits, it
+ * is released to the next thread that starts counting, and keeps its counts. Summing every Shard
+ * therefore counts every thread, past and present.
+ */
+struct Shard {
+  Shard *next;
+  bool inUse;
+  Counters *pages[INSTRUMENTATION_PAGES];
+};
+
+/**
+ * @brief Every Shard, most recently created first.
+ */
+static Shard *_shards;
+
+/**
+ * @brief The Shard of the calling thread.
+ */
+static __thread Shard *_shard;
+
+/**
+ * @brief Releases the Shard of an exiting thread.
+ */
+static pthread_key_t _shardKey;
+
+/**
+ * @brief The `pthread_key_t` destructor, releasing `data` to another thread.
+ */
+static void releaseShard(ident data) {
+
+  Shard *shard = data;
+
+  __atomic_store_n(&shard->inUse, false, __ATOMIC_RELEASE);
+}
+
+/**
+ * @return The Shard of the calling thread, acquiring one if it has none.
+ */
+static Shard *shard(void) {
+
+  Shard *shard = _shard;
+  if (shard == NULL) {
+
+    static Once once;
+    do_once(&once, {
+      const int err = pthread_key_create(&_shardKey, releaseShard);
+      assert(err == 0);
+    });
+
+    for (shard = __atomic_load_n(&_shards, __ATOMIC_ACQUIRE); shard; shard = shard->next) {
+      bool inUse = false;
+      if (__atomic_compare_exchange_n(&shard->inUse, &inUse, true, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)) {
+        break;
+      }
+    }
+
+    if (shard == NULL) {
+      shard = calloc(1, sizeof(Shard));
+      assert(shard);
+
+      shard->inUse = true;
+
+      shard->next = __atomic_load_n(&_shards, __ATOMIC_RELAXED);
+      while (!__atomic_compare_exchange_n(&_shards, &shard->next, shard, 1,
+          __ATOMIC_RELEASE, __ATOMIC_RELAXED)) ;
+    }
+
+    _shard = shard;
+    pthread_setspecific(_shardKey, shard);
+  }
+
+  return shard;
+}
+
+/**
+ * @return The calling thread's Counters for the given Class.
+ */
+static Counters *counters(const Class *clazz) {
+
+  Shard *s = shard();
+
+  const size_t page = clazz->index / INSTRUMENTATION_PAGE_SIZE;
+  assert(page < INSTRUMENTATION_PAGES);
+
+  Counters *counters = s->pages[page];
+  if (counters == NULL) {
+    counters = calloc(INSTRUMENTATION_PAGE_SIZE, sizeof(Counters));
+    assert(counters);
+
+    __atomic_store_n(&s->pages[page], counters, __ATOMIC_RELEASE);
+  }
+
+  return counters + clazz->index % INSTRUMENTATION_PAGE_SIZE;
+}
+
+/**
+ * @brief Reports `delta` live instances of `clazz`, raising its high-water mark if need be.
+ */
+static void report(Class *clazz, long delta) {
+
+  const size_t live = __atomic_add_fetch(&clazz->liveInstances, delta, __ATOMIC_RELAXED);
+
+  size_t highWaterMark = __atomic_load_n(&clazz->highWaterMark, __ATOMIC_RELAXED);
+  while ((long) live > (long) highWaterMark) {
+    if (__atomic_compare_exchange_n(&clazz->highWaterMark, &highWaterMark, live, 1,
+        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+      break;
+    }
+  }
+}
+
+void InstrumentationAlloc(Class *clazz) {
+
+  Counters *c = counters(clazz);
+
+  __atomic_store_n(&c->allocations, c->allocations + 1, __ATOMIC_RELAXED);
+
+  if (++c->pending == INSTRUMENTATION_BATCH) {
+    report(clazz, c->pending);
+    c->pending = 0;
+  }
+}
+
+void InstrumentationDealloc(Class *clazz) {
+
+  Counters *c = counters(clazz);
+
+  __atomic_store_n(&c->deallocations, c->deallocations + 1, __ATOMIC_RELAXED);
+
+  if (--c->pending == -INSTRUMENTATION_BATCH) {
+    report(clazz, c->pending);
+    c->pending = 0;
+  }
+}
+
+ClassStats InstrumentationGetStats(const Class *clazz) {
+
+  assert(clazz);
+
+  ClassStats stats = {
+    .clazz = clazz
+  };
+
+  const size_t page = clazz->index / INSTRUMENTATION_PAGE_SIZE;
+
+  size_t deallocations = 0;
+
+  for (const Shard *s = __atomic_load_n(&_shards, __ATOMIC_ACQUIRE); s; s = s->next) {
+    const Counters *counters = __atomic_load_n(&s->pages[page], __ATOMIC_ACQUIRE);
+    if (counters) {
+      const Counters *c = counters + clazz->index % INSTRUMENTATION_PAGE_SIZE;
+
+      stats.totalAllocations += __atomic_load_n(&c->allocations, __ATOMIC_RELAXED);
+      deallocations += __atomic_load_n(&c->deallocations, __ATOMIC_RELAXED);
+    }
+  }
+
+  /* The Shards are read one after another while threads keep counting, so an
+   * instance allocated and deallocated meanwhile may be seen only deallocated. */
+  if (stats.totalAllocations > deallocations) {
+    stats.liveInstances = stats.totalAllocations - deallocations;
+  }
+
+  stats.liveBytes = stats.liveInstances * clazz->def.instanceSize;
+
+  stats.highWaterMark = __atomic_load_n(&clazz->highWaterMark, __ATOMIC_RELAXED);
+  if (stats.liveInstances > stats.highWaterMark) {
+    stats.highWaterMark = stats.liveInstances;
+  }
+
+  return stats;
+}
+
+/**
+ * @brief The context of InstrumentationEnumerate.
+ */
+typedef struct {
+  ClassStatsEnumerator enumerator;
+  ident data;
+} Enumeration;
+
+/**
+ * @brief ClassEnumerator for InstrumentationEnumerate.
+ */
+static void enumerate(Class *clazz, ident data) {
+
+  const Enumeration *enumeration = data;
+
+  const ClassStats stats = InstrumentationGetStats(clazz);
+  enumeration->enumerator(&stats, enumeration->data);
+}
+
+void InstrumentationEnumerate(ClassStatsEnumerator enumerator, ident data) {
+
+  assert(enumerator);
+
+  enumerateClasses(enumerate, &(Enumeration) {
+    .enumerator = enumerator,
+    .data = data
+  });
+}
+
+/**
+ * @brief The context of InstrumentationDump.
+ */
+typedef struct {
+  int fd;
+  size_t count;
+  char line[512];
+  size_t length;
+} Dump;
+
+/**
+ * @brief Appends `chars` to the line, truncating it if it is full.
+ * @remarks `snprintf` is not async-signal-safe, so the line is formatted by hand.
+ */
+static void appendCharacters(Dump *d, const char *chars) {
+
+  while (*chars && d->length < sizeof(d->line)) {
+    d->line[d->length++] = *chars++;
+  }
+}
+
+/**
+ * @brief Appends the decimal representation of `value` to the line.
+ */
+static void appendSize(Dump *d, size_t value) {
+
+  char digits[20];
+  size_t i = sizeof(digits);
+
+  do {
+    digits[--i] = '0' + value % 10;
+    value /= 10;
+  } while (value);
+
+  while (i < sizeof(digits) && d->length < sizeof(d->line)) {
+    d->line[d->length++] = digits[i++];
+  }
+}
+
+/**
+ * @brief ClassStatsEnumerator for InstrumentationDump.
+ */
+static void dump(const ClassStats *stats, ident data) {
+
+  Dump *d = data;
+
+  d->length = 0;
+
+  appendCharacters(d, d->count++ ? ",\n  {\"name\": \"" : "\n  {\"name\": \"");
+  appendCharacters(d, stats->clazz->def.name);
+  appendCharacters(d, "\", \"instanceSize\": ");
+  appendSize(d, stats->clazz->def.instanceSize);
+  appendCharacters(d, ", \"liveInstances\": ");
+  appendSize(d, stats->liveInstances);
+  appendCharacters(d, ", \"liveBytes\": ");
+  appendSize(d, stats->liveBytes);
+  appendCharacters(d, ", \"totalAllocations\": ");
+  appendSize(d, stats->totalAllocations);
+  appendCharacters(d, ", \"highWaterMark\": ");
+  appendSize(d, stats->highWaterMark);
+  appendCharacters(d, "}");
+
+  write(d->fd, d->line, d->length);
+}
+
+void InstrumentationDump(int fd) {
+
+  Dump d = {
+    .fd = fd
+  };
+
+  write(fd, "[", 1);
+  InstrumentationEnumerate(dump, &d);
+  write(fd, "\n]\n", 3);
+}
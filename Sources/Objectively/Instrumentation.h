@@ -0,0 +1,115 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/Class.h>
+
+/**
+ * @file
+ * @brief Per-Class allocation counters.
+ * @details `_alloc` and `_dealloc` count every instance of every Class, in counters sharded per
+ * thread, so that counting never contends. Those are summed on demand, to answer which Classes
+ * hold the most memory, or allocate the most, in a running application.
+ * @remarks To dump the counters on a signal, set the environment variable
+ * `OBJECTIVELY_INSTRUMENTATION_SIGNAL` to its number, e.g. `10` for `SIGUSR1` on Linux. They
+ * are written to `stderr`.
+ * @ingroup Core
+ */
+
+/**
+ * @brief Allocation counters of a Class.
+ */
+typedef struct {
+
+  /**
+   * @brief The Class.
+   */
+  const Class *clazz;
+
+  /**
+   * @brief The number of instances allocated and not yet deallocated.
+   */
+  size_t liveInstances;
+
+  /**
+   * @brief The number of bytes held by those instances.
+   */
+  size_t liveBytes;
+
+  /**
+   * @brief The number of instances ever allocated.
+   */
+  size_t totalAllocations;
+
+  /**
+   * @brief The greatest number of live instances observed.
+   * @remarks Threads report changes in batches, so this may trail a momentary peak by up to
+   * `INSTRUMENTATION_BATCH` instances for each thread.
+   */
+  size_t highWaterMark;
+} ClassStats;
+
+/**
+ * @brief The number of allocations or deallocations a thread counts on its own before
+ * updating the high-water mark of a Class.
+ */
+#define INSTRUMENTATION_BATCH 64
+
+/**
+ * @brief The ClassStats enumerator type.
+ * @param stats The ClassStats.
+ * @param data User data.
+ */
+typedef void (*ClassStatsEnumerator)(const ClassStats *stats, ident data);
+
+/**
+ * @brief Counts an instance of `clazz` allocated by the calling thread.
+ * @remarks Called by `_alloc`.
+ */
+OBJECTIVELY_EXPORT void InstrumentationAlloc(Class *clazz);
+
+/**
+ * @brief Counts an instance of `clazz` deallocated by the calling thread.
+ * @remarks Called by `_dealloc`.
+ */
+OBJECTIVELY_EXPORT void InstrumentationDealloc(Class *clazz);
+
+/**
+ * @return The ClassStats of the given Class, summed across all threads.
+ */
+OBJECTIVELY_EXPORT ClassStats InstrumentationGetStats(const Class *clazz);
+
+/**
+ * @brief Enumerates the ClassStats of every initialized Class.
+ * @param enumerator The ClassStatsEnumerator.
+ * @param data User data.
+ */
+OBJECTIVELY_EXPORT void InstrumentationEnumerate(ClassStatsEnumerator enumerator, ident data);
+
+/**
+ * @brief Writes the ClassStats of every initialized Class to `fd`, as a JSON array.
+ * @param fd The file descriptor.
+ * @remarks Neither allocates, locks, nor uses stdio, so this may be called from a signal handler.
+ */
+OBJECTIVELY_EXPORT void InstrumentationDump(int fd);
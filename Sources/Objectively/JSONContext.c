@@ -36,6 +36,7 @@
 #include "Null.h"
 #include "Number.h"
 #include "String.h"
+#include "StringBuilder.h"
 
 #define _Class _JSONContext
 
@@ -92,7 +93,7 @@ static void addError(JSONContext *self, int code, const char *key, const char *d
  * @brief Internal state for JSON text generation.
  */
 typedef struct {
-  Data *data;
+  StringBuilder *builder;
   int options;
   size_t depth;
 } JSONWriter;
@@ -104,7 +105,7 @@ static void writeElement(JSONWriter *writer, const ident obj);
  */
 static void writeNull(JSONWriter *writer, const Null *null) {
 
-  $(writer->data, appendBytes, (uint8_t *) "null", 4);
+  $(writer->builder, appendBytes, (uint8_t *) "null", 4);
 }
 
 /**
@@ -113,9 +114,9 @@ static void writeNull(JSONWriter *writer, const Null *null) {
 static void writeBoole(JSONWriter *writer, const Boole *boolean) {
 
   if (boolean->value) {
-    $(writer->data, appendBytes, (uint8_t *) "true", 4);
+    $(writer->builder, appendBytes, (uint8_t *) "true", 4);
   } else {
-    $(writer->data, appendBytes, (uint8_t *) "false", 5);
+    $(writer->builder, appendBytes, (uint8_t *) "false", 5);
   }
 }
 
@@ -124,33 +125,33 @@ static void writeBoole(JSONWriter *writer, const Boole *boolean) {
  */
 static void writeString(JSONWriter *writer, const String *string) {
 
-  $(writer->data, appendBytes, (uint8_t *) "\"", 1);
+  $(writer->builder, appendBytes, (uint8_t *) "\"", 1);
 
   const char *s = string->chars;
   const char *end = s + string->length;
   while (s < end) {
     const unsigned char c = (unsigned char) *s++;
     switch (c) {
-      case '"':  $(writer->data, appendBytes, (uint8_t *) "\\\"", 2); break;
-      case '\\': $(writer->data, appendBytes, (uint8_t *) "\\\\", 2); break;
-      case '\b': $(writer->data, appendBytes, (uint8_t *) "\\b",  2); break;
-      case '\f': $(writer->data, appendBytes, (uint8_t *) "\\f",  2); break;
-      case '\n': $(writer->data, appendBytes, (uint8_t *) "\\n",  2); break;
-      case '\r': $(writer->data, appendBytes, (uint8_t *) "\\r",  2); break;
-      case '\t': $(writer->data, appendBytes, (uint8_t *) "\\t",  2); break;
+      case '"':  $(writer->builder, appendBytes, (uint8_t *) "\\\"", 2); break;
+      case '\\': $(writer->builder, appendBytes, (uint8_t *) "\\\\", 2); break;
+      case '\b': $(writer->builder, appendBytes, (uint8_t *) "\\b",  2); break;
+      case '\f': $(writer->builder, appendBytes, (uint8_t *) "\\f",  2); break;
+      case '\n': $(writer->builder, appendBytes, (uint8_t *) "\\n",  2); break;
+      case '\r': $(writer->builder, appendBytes, (uint8_t *) "\\r",  2); break;
+      case '\t': $(writer->builder, appendBytes, (uint8_t *) "\\t",  2); break;
       default:
         if (c < 0x20) {
           char seq[7];
           snprintf(seq, sizeof(seq), "\\u%04x", c);
-          $(writer->data, appendBytes, (uint8_t *) seq, 6);
+          $(writer->builder, appendBytes, (uint8_t *) seq, 6);
         } else {
-          $(writer->data, appendBytes, (uint8_t *) &c, 1);
+          $(writer->builder, appendBytes, (uint8_t *) &c, 1);
         }
         break;
     }
   }
 
-  $(writer->data, appendBytes, (uint8_t *) "\"", 1);
+  $(writer->builder, appendBytes, (uint8_t *) "\"", 1);
 }
 
 /**
@@ -160,9 +161,7 @@ static void writeNumber(JSONWriter *writer, const Number *number) {
 
   // Use enough significant digits to preserve 32-bit epoch seconds and other
   // large integers exactly when round-tripping through JSON.
-  String *string = $(alloc(String), initWithFormat, "%.17g", number->value);
-  $(writer->data, appendBytes, (uint8_t *) string->chars, string->length);
-  release(string);
+  $(writer->builder, appendFormat, "%.17g", number->value);
 }
 
 /**
@@ -171,7 +170,7 @@ static void writeNumber(JSONWriter *writer, const Number *number) {
 static void writeLabel(JSONWriter *writer, const String *label) {
 
   writeString(writer, label);
-  $(writer->data, appendBytes, (uint8_t *) ": ", 2);
+  $(writer->builder, appendBytes, (uint8_t *) ": ", 2);
 }
 
 /**
@@ -180,9 +179,9 @@ static void writeLabel(JSONWriter *writer, const String *label) {
 static void writePretty(JSONWriter *writer) {
 
   if (writer->options & JSON_WRITE_PRETTY) {
-    $(writer->data, appendBytes, (uint8_t *) "\n", 1);
+    $(writer->builder, appendBytes, (uint8_t *) "\n", 1);
     for (size_t i = 0; i < writer->depth; i++) {
-      $(writer->data, appendBytes, (uint8_t *) "  ", 2);
+      $(writer->builder, appendBytes, (uint8_t *) "  ", 2);
     }
   }
 }
@@ -192,7 +191,7 @@ static void writePretty(JSONWriter *writer) {
  */
 static void writeObject(JSONWriter *writer, const Dictionary *object) {
 
-  $(writer->data, appendBytes, (uint8_t *) "{", 1);
+  $(writer->builder, appendBytes, (uint8_t *) "{", 1);
   writer->depth++;
 
   Array *keys = $(object, allKeys);
@@ -213,7 +212,7 @@ static void writeObject(JSONWriter *writer, const Dictionary *object) {
     writeElement(writer, obj);
 
     if (i < keys->count - 1) {
-      $(writer->data, appendBytes, (uint8_t *) ",", 1);
+      $(writer->builder, appendBytes, (uint8_t *) ",", 1);
     }
   }
 
@@ -222,7 +221,7 @@ static void writeObject(JSONWriter *writer, const Dictionary *object) {
   writer->depth--;
   writePretty(writer);
 
-  $(writer->data, appendBytes, (uint8_t *) "}", 1);
+  $(writer->builder, appendBytes, (uint8_t *) "}", 1);
 }
 
 /**
@@ -230,7 +229,7 @@ static void writeObject(JSONWriter *writer, const Dictionary *object) {
  */
 static void writeArray(JSONWriter *writer, const Array *array) {
 
-  $(writer->data, appendBytes, (uint8_t *) "[", 1);
+  $(writer->builder, appendBytes, (uint8_t *) "[", 1);
   writer->depth++;
 
   for (size_t i = 0; i < array->count; i++) {
@@ -239,14 +238,14 @@ static void writeArray(JSONWriter *writer, const Array *array) {
     writeElement(writer, $(array, objectAtIndex, i));
 
     if (i < array->count - 1) {
-      $(writer->data, appendBytes, (uint8_t *) ",", 1);
+      $(writer->builder, appendBytes, (uint8_t *) ",", 1);
     }
   }
 
   writer->depth--;
   writePretty(writer);
 
-  $(writer->data, appendBytes, (uint8_t *) "]", 1);
+  $(writer->builder, appendBytes, (uint8_t *) "]", 1);
 }
 
 /**
@@ -470,12 +469,39 @@ static Null *readNull(JSONReader *reader) {
 
 /**
  * @brief Reads a JSON object key label from `reader`.
+ * @details Labels are interned unless `JSON_READ_NO_INTERN` is set. A label without escapes is
+ * interned directly from the input, so that a key seen before costs no allocation.
  */
 static String *readLabel(JSONReader *reader) {
 
   const int b = readByteUntil(reader, "\"}");
   if (b == '"') {
-    return readString(reader);
+
+    if (reader->options & JSON_READ_NO_INTERN) {
+      return readString(reader);
+    }
+
+    const uint8_t *start = reader->b + 1;
+    const uint8_t *end = reader->data->bytes + reader->data->length;
+
+    for (const uint8_t *c = start; c < end; c++) {
+      if (*c == '"') {
+        reader->b = (uint8_t *) c;
+        return $$(String, internedStringWithCharacters, (const char *) start, c - start);
+      }
+      if (*c == '\\') {
+        break;
+      }
+    }
+
+    String *label = readString(reader);
+    if (label) {
+      String *interned = $(label, internedString);
+      release(label);
+      return interned;
+    }
+
+    return NULL;
   }
   if (b == '}') {
     reader->b--;
@@ -587,13 +613,17 @@ static Data *dataFromObject(JSONContext *self, const ident obj, int options) {
 
   if (obj) {
     JSONWriter writer = {
-      .data = $(alloc(Data), init),
+      .builder = $(alloc(StringBuilder), init),
       .options = options
     };
 
     writeElement(&writer, obj);
 
-    return (Data *) writer.data;
+    Data *data = $(writer.builder, data);
+
+    release(writer.builder);
+
+    return data;
   }
 
   return NULL;
@@ -714,9 +744,7 @@ static bool structFromDictionary(JSONContext *self, const JSONProperties *proper
       continue;
     }
 
-    String *key = $$(String, stringWithCharacters, p->key);
-    const Object *val = $(dictionary, objectForKey, key);
-    release(key);
+    const Object *val = $(dictionary, objectForKeyWithCharacters, p->key, strlen(p->key));
 
     if (!val) {
       continue;
@@ -37,6 +37,27 @@
 
 typedef struct JSONContextInterface JSONContextInterface;
 
+// ---------------------------------------------------------------------------
+// JSONReadOptions
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Options for JSON deserialization.
+ */
+typedef enum {
+
+  /**
+   * @brief Disables interning of JSON object keys.
+   * @details By default, each key is the interned String for its characters, so that documents
+   * repeating the same keys share one String per key, and Dictionary lookups by an interned key
+   * compare pointers. Interned Strings are never freed, so set this when reading documents whose
+   * keys are unbounded, such as those from an untrusted source.
+   * @see String::internedStringWithCharacters(const char *, size_t)
+   */
+  JSON_READ_NO_INTERN = 0x1,
+
+} JSONReadOptions;
+
 // ---------------------------------------------------------------------------
 // JSONWriteOptions
 // ---------------------------------------------------------------------------
@@ -158,7 +179,7 @@ struct JSONContextInterface {
    * @brief Parses a JSON Data buffer into an Objectively object graph.
    * @param self The JSONContext.
    * @param data The JSON Data to parse.
-   * @param options Reserved; pass 0.
+   * @param options A bitwise-or of JSONReadOptions.
    * @return The root Object (Dictionary or Array), or `NULL` on parse error.
    * @memberof JSONContext
    */
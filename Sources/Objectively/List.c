@@ -344,7 +344,37 @@ static void removeNode(List *self, ListNode *node) {
 }
 
 /**
- * @fn void List::sort(List *self, ListSortFunc sort)
+ * @brief Merges the sorted, `NULL`-terminated runs `a` and `b` along their `next` links.
+ * @details Ties are taken from `a`, so that the merge is stable.
+ * @return The head of the merged run.
+ */
+static ListNode *merge(ListNode *a, ListNode *b, Comparator comparator) {
+
+  ListNode head = { .next = NULL }, *tail = &head;
+
+  while (a && b) {
+    if (comparator(a->element, b->element) > OrderSame) {
+      tail->next = b;
+      b = b->next;
+    } else {
+      tail->next = a;
+      a = a->next;
+    }
+    tail = tail->next;
+  }
+
+  tail->next = a ? a : b;
+
+  return head.next;
+}
+
+/**
+ * @brief The number of runs `List::sort` holds while merging, enough for 2^64 nodes.
+ */
+#define LIST_SORT_RUNS 64
+
+/**
+ * @fn void List::sort(List *self, Comparator comparator)
  * @memberof List
  */
 static void _sort(List *self, Comparator comparator) {
@@ -355,19 +385,40 @@ static void _sort(List *self, Comparator comparator) {
     return;
   }
 
-  for (ListNode *node = self->head->next; node; ) {
+  /* Bottom-up merge sort: runs[i] is a sorted run of 2^i nodes, or NULL. Each node is merged in
+   * as a run of one, and carries upward like a binary counter, so that only `next` is touched. */
+  ListNode *runs[LIST_SORT_RUNS] = { NULL };
+
+  for (ListNode *node = self->head; node; ) {
     ListNode *next = node->next;
-    ident key = node->element;
+    node->next = NULL;
 
-    ListNode *j = node->prev;
-    while (j && comparator(j->element, key) > OrderSame) {
-      j->next->element = j->element;
-      j = j->prev;
+    size_t i = 0;
+    for (; runs[i]; i++) {
+      node = merge(runs[i], node, comparator);
+      runs[i] = NULL;
     }
 
-    (j ? j->next : self->head)->element = key;
+    runs[i] = node;
     node = next;
   }
+
+  ListNode *head = NULL;
+  for (size_t i = 0; i < LIST_SORT_RUNS; i++) {
+    if (runs[i]) {
+      head = merge(runs[i], head, comparator);
+    }
+  }
+
+  /* Finally, restore the `prev` links and the tail. */
+  ListNode *prev = NULL;
+  for (ListNode *node = head; node; node = node->next) {
+    node->prev = prev;
+    prev = node;
+  }
+
+  self->head = head;
+  self->tail = prev;
 }
 
 #pragma mark - Class lifecycle
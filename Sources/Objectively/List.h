@@ -260,6 +260,8 @@ struct ListInterface {
    * @brief Sorts this List in-place using the given comparator.
    * @param self The List.
    * @param comparator The Comparator.
+   * @remarks The sort is a stable merge sort, which relinks nodes rather than moving elements, so
+   * ListNode pointers held by the caller remain valid and keep their elements.
    * @memberof List
    */
   void (*sort)(List *self, Comparator comparator);
@@ -214,7 +214,7 @@ static Log *sharedInstance(void) {
   static Once once;
 
   do_once(&once, {
-    _sharedInstance = $(alloc(Log), init);
+    _sharedInstance = immortalize($(alloc(Log), init));
   });
 
   return _sharedInstance;
@@ -255,7 +255,10 @@ static void warn(const Log *self, const char *fmt, ...) {
  */
 static void destroy(Class *clazz) {
 
-  _sharedInstance = release(_sharedInstance);
+  if (_sharedInstance) {
+    $((Object *) _sharedInstance, dealloc);
+    _sharedInstance = NULL;
+  }
 }
 
 /**
@@ -22,6 +22,8 @@
  */
 
 #include <assert.h>
+#include <math.h>
+#include <string.h>
 
 #include "Hash.h"
 #include "Number.h"
@@ -29,6 +31,14 @@
 
 #define _Class _Number
 
+#define NUMBER_CACHE_MIN -256
+#define NUMBER_CACHE_MAX 1023
+
+/**
+ * @brief Immortal Numbers for the small integers, created as they are first requested.
+ */
+static Number *_numbers[NUMBER_CACHE_MAX - NUMBER_CACHE_MIN + 1];
+
 #pragma mark - Object
 
 /**
@@ -48,7 +58,12 @@ static int hash(const Object *self) {
 
   Number *this = (Number *) self;
 
-  return HashForDecimal(HASH_SEED, this->value);
+  uint64_t bits = 0;
+  if (this->value != 0.0) {
+    memcpy(&bits, &this->value, sizeof(bits));
+  }
+
+  return (int) Hash64ForInteger(Hash64Seed(), bits);
 }
 
 /**
@@ -157,6 +172,25 @@ static long longValue(const Number *self) {
  * @memberof Number
  */
 static Number *numberWithValue(double value) {
+
+  if (value >= NUMBER_CACHE_MIN && value <= NUMBER_CACHE_MAX && value == (long) value && !(value == 0 && signbit(value))) {
+
+    Number **number = &_numbers[(long) value - NUMBER_CACHE_MIN];
+
+    Number *cached = __atomic_load_n(number, __ATOMIC_ACQUIRE);
+    if (cached == NULL) {
+      Number *created = immortalize($(alloc(Number), initWithValue, value));
+
+      if (__atomic_compare_exchange_n(number, &cached, created, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        cached = created;
+      } else {
+        $((Object *) created, dealloc);
+      }
+    }
+
+    return cached;
+  }
+
   return $(alloc(Number), initWithValue, value);
 }
 
@@ -170,6 +204,18 @@ static short shortValue(const Number *self) {
 
 #pragma mark - Class lifecycle
 
+/**
+ * @see Class::destroy(Class *)
+ */
+static void destroy(Class *clazz) {
+
+  for (size_t i = 0; i < lengthof(_numbers); i++) {
+    if (_numbers[i]) {
+      $((Object *) _numbers[i], dealloc);
+    }
+  }
+}
+
 /**
  * @see Class::initialize(Class *)
  */
@@ -207,6 +253,7 @@ Class *_Number(void) {
       .interfaceOffset = offsetof(Number, interface),
       .interfaceSize = sizeof(NumberInterface),
       .initialize = initialize,
+      .destroy = destroy,
     });
   });
 
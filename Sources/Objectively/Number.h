@@ -138,9 +138,11 @@ struct NumberInterface {
   /**
    * @static
    * @fn Number *Number::numberWithValue(double value)
-   * @brief Returns a new Number with the given value.
+   * @brief Returns a Number with the given value.
    * @param value The value.
-   * @return The new Number, or `NULL` on error.
+   * @return The Number, or `NULL` on error.
+   * @remarks Small integral values, which dominate most JSON, are answered by shared, immortal
+   * Numbers, so that no allocation occurs. Use `Number::initWithValue` for a distinct instance.
    * @memberof Number
    */
   Number *(*numberWithValue)(double value);
@@ -56,7 +56,7 @@ static Number *numberFromString(const NumberFormatter *self, const String *strin
 
     const int res = sscanf(string->chars, self->fmt, &value);
     if (res == 1) {
-      return $(alloc(Number), initWithValue, value);
+      return $$(Number, numberWithValue, value);
     }
   }
 
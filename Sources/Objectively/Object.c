@@ -38,11 +38,12 @@
  */
 static Object *copy(const Object *self) {
 
-  ident obj = calloc(1, self->clazz->def.instanceSize);
+  ident obj = _alloc(self->clazz);
   assert(obj);
 
   Object *object = memcpy(obj, self, self->clazz->def.instanceSize);
   object->referenceCount = 1;
+  object->flags = 0;
 
   return object;
 }
@@ -53,7 +54,7 @@ static Object *copy(const Object *self) {
  */
 static void dealloc(Object *self) {
 
-  free(self);
+  _dealloc(self);
 }
 
 /**
@@ -101,16 +102,8 @@ static bool isEqual(const Object *self, const Object *other) {
 static bool isKindOfClass(const Object *self, const Class *clazz) {
 
   assert(clazz);
-  
-  const Class *c = self->clazz;
-  while (c) {
-    if (memcmp(c, clazz, sizeof(*c)) == 0) {
-      return true;
-    }
-    c = c->def.superclass;
-  }
-
-  return false;
+
+  return issubclassof(self->clazz, clazz);
 }
 
 #pragma mark - Class lifecycle
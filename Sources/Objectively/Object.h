@@ -38,6 +38,32 @@
 typedef struct Object Object;
 typedef struct ObjectInterface ObjectInterface;
 
+/**
+ * @brief Flags describing how an Object is owned.
+ */
+typedef enum {
+
+  /**
+   * @brief The Object was allocated from an AutoreleasePool's arena, which owns it.
+   * @details `retain` and `release` ignore it, and the pool deallocates it when drained.
+   */
+  OBJECT_ARENA = 0x1,
+
+  /**
+   * @brief The Object lives until its Class is destroyed, regardless of its reference count.
+   * @details `retain` and `release` ignore it, so that a singleton shared by many threads does
+   * not have its reference count contended by all of them.
+   * @see immortalize(ident)
+   */
+  OBJECT_IMMORTAL = 0x2,
+
+  /**
+   * @brief The Object was statically allocated, and so is never deallocated.
+   * @details Set alongside `OBJECT_IMMORTAL`, for instance by `strlit`.
+   */
+  OBJECT_STATIC = 0x4,
+} ObjectFlags;
+
 /**
  * @brief Object is the _root Class_ of The Objectively Class hierarchy.
  * @details Every Class descends from Object, and every instance can be cast to Object.
@@ -65,6 +91,12 @@ struct Object {
    * @private
    */
   unsigned int referenceCount;
+
+  /**
+   * @brief The ObjectFlags of this Object.
+   * @private
+   */
+  unsigned int flags;
 };
 
 typedef struct String String;
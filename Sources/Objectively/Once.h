@@ -38,10 +38,14 @@ typedef long Once;
 
 /**
  * @brief Executes the given `block` at most one time.
+ * @remarks Once `block` has run, this costs a single load, so archetypes may call it freely.
  * @ingroup Concurrency
  */
 #define do_once(once, block) \
     do { \
+      if (__atomic_load_n(once, __ATOMIC_ACQUIRE) == 1) { \
+        break; \
+      } \
       Once _pending = 0; \
       if (__atomic_compare_exchange_n(once, &_pending, -1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) { \
         block; __atomic_store_n(once, 1, __ATOMIC_RELEASE); \
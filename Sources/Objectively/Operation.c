@@ -186,9 +186,9 @@ static void start(Operation *self) {
     self->isExecuting = false;
   }
 
-  self->isFinished = true;
-
+  /* Finish under the lock, so that waiters see everything `function` wrote. */
   synchronized(self->locals.condition, {
+    self->isFinished = true;
     $(self->locals.condition, broadcast);
   });
 }
@@ -21,8 +21,18 @@
  * 3. This notice may not be removed or altered from any source distribution.
  */
 
+#include "Config.h"
+
 #include <assert.h>
 
+#if defined(_WIN32)
+#include <Windows.h>
+#endif
+
+#if HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
 #include "OperationQueue.h"
 
 #define _Class _OperationQueue
@@ -280,6 +290,40 @@ static void resume(OperationQueue *self) {
   });
 }
 
+static OperationQueue *_sharedQueue;
+
+/**
+ * @return The number of processors available to this process.
+ */
+static size_t processors(void) {
+
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+
+  return max(info.dwNumberOfProcessors, 1);
+#elif defined(_SC_NPROCESSORS_ONLN)
+  return max(sysconf(_SC_NPROCESSORS_ONLN), 1);
+#else
+  return 1;
+#endif
+}
+
+/**
+ * @fn OperationQueue *OperationQueue::sharedQueue(void)
+ * @memberof OperationQueue
+ */
+static OperationQueue *sharedQueue(void) {
+
+  static Once once;
+
+  do_once(&once, {
+    _sharedQueue = immortalize($(alloc(OperationQueue), initWithMaxConcurrentOperations, processors()));
+  });
+
+  return _sharedQueue;
+}
+
 /**
  * @fn void OperationQueue::suspend(OperationQueue *self)
  * @memberof OperationQueue
@@ -320,6 +364,17 @@ static void waitUntilAllOperationsAreFinished(OperationQueue *self) {
 
 #pragma mark - Class lifecycle
 
+/**
+ * @see Class::destroy(Class *)
+ */
+static void destroy(Class *clazz) {
+
+  if (_sharedQueue) {
+    $((Object *) _sharedQueue, dealloc);
+    _sharedQueue = NULL;
+  }
+}
+
 /**
  * @see Class::initialize(Class *)
  */
@@ -338,6 +393,7 @@ static void initialize(Class *clazz) {
   ((OperationQueueInterface *) clazz->interface)->operations = operations;
   ((OperationQueueInterface *) clazz->interface)->removeOperation = removeOperation;
   ((OperationQueueInterface *) clazz->interface)->resume = resume;
+  ((OperationQueueInterface *) clazz->interface)->sharedQueue = sharedQueue;
   ((OperationQueueInterface *) clazz->interface)->suspend = suspend;
   ((OperationQueueInterface *) clazz->interface)->waitUntilAllOperationsAreFinished = waitUntilAllOperationsAreFinished;
 }
@@ -358,6 +414,7 @@ Class *_OperationQueue(void) {
       .interfaceOffset = offsetof(OperationQueue, interface),
       .interfaceSize = sizeof(OperationQueueInterface),
       .initialize = initialize,
+      .destroy = destroy,
     });
   });
 
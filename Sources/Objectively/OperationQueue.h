@@ -187,6 +187,16 @@ struct OperationQueueInterface {
    */
   void (*resume)(OperationQueue *self);
 
+  /**
+   * @static
+   * @fn OperationQueue *OperationQueue::sharedQueue(void)
+   * @return The shared OperationQueue, which runs one Operation per available processor.
+   * @remarks The shared queue is created on first use, and lives until the OperationQueue Class
+   * is destroyed. It is the default queue for the `parallel` methods of Array and Vector.
+   * @memberof OperationQueue
+   */
+  OperationQueue *(*sharedQueue)(void);
+
   /**
    * @fn void OperationQueue::suspend(OperationQueue *self)
    * @brief Suspends this queue, preventing it from starting any new Operations.
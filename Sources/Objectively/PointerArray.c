@@ -30,7 +30,30 @@
 
 #define _Class _PointerArray
 
-#define POINTER_ARRAY_CHUNK_SIZE 64
+/**
+ * @brief The capacity of a PointerArray's first allocation. Each after it doubles.
+ */
+#define POINTER_ARRAY_MIN_CAPACITY 16
+
+/**
+ * @brief Ensures that this PointerArray has room for `count` pointers.
+ * @details Capacity grows geometrically, so that repeated additions are amortized.
+ */
+static void grow(PointerArray *self, size_t count) {
+
+  if (count > self->capacity) {
+
+    size_t capacity = self->capacity << 1;
+    if (capacity < POINTER_ARRAY_MIN_CAPACITY) {
+      capacity = POINTER_ARRAY_MIN_CAPACITY;
+    }
+    if (capacity < count) {
+      capacity = count;
+    }
+
+    $(self, reserveCapacity, capacity);
+  }
+}
 
 #pragma mark - Object
 
@@ -56,15 +79,25 @@ static void dealloc(Object *self) {
  */
 static void add(PointerArray *self, ident pointer) {
 
-  if (self->count == self->capacity) {
+  grow(self, self->count + 1);
 
-    self->capacity += POINTER_ARRAY_CHUNK_SIZE;
+  self->elements[self->count++] = pointer;
+}
 
-    self->elements = realloc(self->elements, self->capacity * sizeof(ident ));
-    assert(self->elements);
-  }
+/**
+ * @fn void PointerArray::addPointers(PointerArray *self, size_t count, const ident *pointers)
+ * @memberof PointerArray
+ */
+static void addPointers(PointerArray *self, size_t count, const ident *pointers) {
 
-  self->elements[self->count++] = pointer;
+  if (count) {
+    assert(pointers);
+
+    grow(self, self->count + count);
+
+    memcpy(self->elements + self->count, pointers, count * sizeof(ident));
+    self->count += count;
+  }
 }
 
 /**
@@ -147,6 +180,41 @@ static void removeAt(PointerArray *self, size_t index) {
   self->count--;
 }
 
+/**
+ * @fn void PointerArray::reserveCapacity(PointerArray *self, size_t capacity)
+ * @memberof PointerArray
+ */
+static void reserveCapacity(PointerArray *self, size_t capacity) {
+
+  if (capacity > self->capacity) {
+
+    self->elements = realloc(self->elements, capacity * sizeof(ident));
+    assert(self->elements);
+
+    self->capacity = capacity;
+  }
+}
+
+/**
+ * @fn void PointerArray::shrinkToFit(PointerArray *self)
+ * @memberof PointerArray
+ */
+static void shrinkToFit(PointerArray *self) {
+
+  if (self->capacity > self->count) {
+
+    if (self->count) {
+      self->elements = realloc(self->elements, self->count * sizeof(ident));
+      assert(self->elements);
+    } else {
+      free(self->elements);
+      self->elements = NULL;
+    }
+
+    self->capacity = self->count;
+  }
+}
+
 /**
  * @fn void PointerArray::sort(PointerArray *self, Comparator comparator)
  * @memberof PointerArray
@@ -165,12 +233,15 @@ static void initialize(Class *clazz) {
   ((ObjectInterface *) clazz->interface)->dealloc = dealloc;
 
   ((PointerArrayInterface *) clazz->interface)->add = add;
+  ((PointerArrayInterface *) clazz->interface)->addPointers = addPointers;
   ((PointerArrayInterface *) clazz->interface)->get = get;
   ((PointerArrayInterface *) clazz->interface)->init = init;
   ((PointerArrayInterface *) clazz->interface)->initWithDestroy = initWithDestroy;
   ((PointerArrayInterface *) clazz->interface)->remove = _remove;
   ((PointerArrayInterface *) clazz->interface)->removeAll = removeAll;
   ((PointerArrayInterface *) clazz->interface)->removeAt = removeAt;
+  ((PointerArrayInterface *) clazz->interface)->reserveCapacity = reserveCapacity;
+  ((PointerArrayInterface *) clazz->interface)->shrinkToFit = shrinkToFit;
   ((PointerArrayInterface *) clazz->interface)->sort = sort;
 }
 
@@ -96,6 +96,16 @@ struct PointerArrayInterface {
    */
   void (*add)(PointerArray *self, ident pointer);
 
+  /**
+   * @fn void PointerArray::addPointers(PointerArray *self, size_t count, const ident *pointers)
+   * @brief Appends `count` pointers to this PointerArray, growing it at most once.
+   * @param self The PointerArray.
+   * @param count The count of `pointers`.
+   * @param pointers The pointers to add.
+   * @memberof PointerArray
+   */
+  void (*addPointers)(PointerArray *self, size_t count, const ident *pointers);
+
   /**
    * @fn ident PointerArray::get(const PointerArray *self, size_t index)
    * @param self The PointerArray.
@@ -150,6 +160,23 @@ struct PointerArrayInterface {
    */
   void (*removeAll)(PointerArray *self);
 
+  /**
+   * @fn void PointerArray::reserveCapacity(PointerArray *self, size_t capacity)
+   * @brief Ensures that this PointerArray can hold `capacity` pointers without growing.
+   * @param self The PointerArray.
+   * @param capacity The desired capacity.
+   * @memberof PointerArray
+   */
+  void (*reserveCapacity)(PointerArray *self, size_t capacity);
+
+  /**
+   * @fn void PointerArray::shrinkToFit(PointerArray *self)
+   * @brief Releases any capacity this PointerArray holds beyond its count.
+   * @param self The PointerArray.
+   * @memberof PointerArray
+   */
+  void (*shrinkToFit)(PointerArray *self);
+
   /**
    * @fn void PointerArray::sort(PointerArray *self, Comparator comparator)
    * @brief Sorts this PointerArray in place using `comparator`.
@@ -24,6 +24,7 @@
 #include <assert.h>
 #include <stdarg.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "Hash.h"
 #include "Set.h"
@@ -32,9 +33,145 @@
 #define _Class _Set
 
 #define SET_DEFAULT_CAPACITY 64
-#define SET_GROW_FACTOR 2.0
 #define SET_MAX_LOAD 0.75f
 
+/**
+ * @return The 64-bit hash of `obj`.
+ */
+static inline size_t hashForObject(const ident obj) {
+  return Hash64ForObject(Hash64Seed(), obj);
+}
+
+/**
+ * @return The entry for `obj`, or the vacant entry at which it would be inserted.
+ * @remarks The table must not be empty, nor full.
+ */
+static SetEntry *entryForObject(const Set *self, const ident obj, size_t hash) {
+
+  const size_t mask = self->capacity - 1;
+
+  for (size_t i = hash & mask; ; i = (i + 1) & mask) {
+
+    SetEntry *entry = self->elements + i;
+    if (entry->obj == NULL) {
+      return entry;
+    }
+
+    if (entry->hash == hash) {
+      if (entry->obj == obj || $((Object *) entry->obj, isEqual, obj)) {
+        return entry;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Vacates `entry`, shifting back any entries that probed past it, so that no tombstone is
+ * left behind.
+ */
+static void vacate(Set *self, SetEntry *entry) {
+
+  const size_t mask = self->capacity - 1;
+
+  size_t i = entry - self->elements;
+
+  for (size_t j = (i + 1) & mask; self->elements[j].obj; j = (j + 1) & mask) {
+
+    const size_t k = self->elements[j].hash & mask;
+    if (((j - k) & mask) >= ((j - i) & mask)) {
+      self->elements[i] = self->elements[j];
+      i = j;
+    }
+  }
+
+  self->elements[i] = (SetEntry) { .obj = NULL };
+}
+
+/**
+ * @brief Shares the entries of `set` with `self`, which must have none of its own.
+ */
+static void share(Set *self, const Set *set) {
+
+  if (set->count == 0) {
+    return;
+  }
+
+  /* Copying is not a mutation, so two threads may copy the same Set at once. */
+  size_t *references = __atomic_load_n(&((Set *) set)->references, __ATOMIC_ACQUIRE);
+  if (references == NULL) {
+
+    size_t *owner = malloc(sizeof(size_t));
+    assert(owner);
+
+    *owner = 1;
+
+    if (__atomic_compare_exchange_n(&((Set *) set)->references, &references, owner, 0,
+        __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      references = owner;
+    } else {
+      free(owner);
+    }
+  }
+
+  __atomic_add_fetch(references, 1, __ATOMIC_RELAXED);
+
+  self->elements = set->elements;
+  self->capacity = set->capacity;
+  self->count = set->count;
+  self->references = references;
+}
+
+/**
+ * @brief Relinquishes this Set's entries, releasing them if no other Set shares them.
+ */
+static void relinquish(Set *self) {
+
+  if (self->references == NULL || __atomic_sub_fetch(self->references, 1, __ATOMIC_ACQ_REL) == 0) {
+
+    for (size_t i = 0; i < self->capacity; i++) {
+      release(self->elements[i].obj);
+    }
+
+    free(self->elements);
+    free(self->references);
+  }
+
+  self->elements = NULL;
+  self->references = NULL;
+}
+
+/**
+ * @brief Ensures that this Set owns its entries outright, before it is mutated.
+ */
+static void unshare(Set *self) {
+
+  size_t *references = self->references;
+  if (references) {
+
+    if (__atomic_load_n(references, __ATOMIC_ACQUIRE) > 1) {
+
+      SetEntry *elements = malloc(self->capacity * sizeof(SetEntry));
+      assert(elements);
+
+      memcpy(elements, self->elements, self->capacity * sizeof(SetEntry));
+
+      for (size_t i = 0; i < self->capacity; i++) {
+        if (elements[i].obj) {
+          retain(elements[i].obj);
+        }
+      }
+
+      /* Every other Set may have let go while these were retained. */
+      relinquish(self);
+
+      self->elements = elements;
+    } else {
+      free(references);
+      self->references = NULL;
+    }
+  }
+}
+
 #pragma mark - Object
 
 /**
@@ -44,9 +181,7 @@ static Object *copy(const Object *self) {
 
   const Set *this = (Set *) self;
 
-  Set *that = $(alloc(Set), initWithCapacity, this->capacity);
-
-  $(that, addObjectsFromSet, this);
+  Set *that = $(alloc(Set), initWithSet, this);
 
   return (Object *) that;
 }
@@ -56,13 +191,7 @@ static Object *copy(const Object *self) {
  */
 static void dealloc(Object *self) {
 
-  Set *this = (Set *) self;
-
-  for (size_t i = 0; i < this->capacity; i++) {
-    release(this->elements[i]);
-  }
-
-  free(this->elements);
+  relinquish((Set *) self);
 
   super(Object, self, dealloc);
 }
@@ -84,15 +213,15 @@ static int hash(const Object *self) {
 
   const Set *this = (Set *) self;
 
-  int hash = HashForInteger(HASH_SEED, this->count);
+  uint64_t hash = 0;
 
   for (size_t i = 0; i < this->capacity; i++) {
-    if (this->elements[i]) {
-      hash = HashForObject(hash, this->elements[i]);
+    if (this->elements[i].obj) {
+      hash += this->elements[i].hash;
     }
   }
 
-  return hash;
+  return (int) Hash64Combine(hash, this->count);
 }
 
 /**
@@ -134,34 +263,69 @@ static bool isEqual(const Object *self, const Object *other) {
 
 /**
  * @brief A helper for resizing Sets as Objects are added to them.
- * @remarks Static method invocations are used for all operations.
+ * @details The table is doubled in place: every entry it held is marked pending, and then moved to
+ * its new position using its cached hash. An entry that lands on one still pending displaces it,
+ * and that one is placed next. Neither `hash` nor `isEqual` is invoked.
  */
 static void addObject_resize(Set *set) {
 
   if (set->capacity) {
 
-    const float load = set->count / (float) set->capacity;
-    if (load >= SET_MAX_LOAD) {
+    const float load = (set->count + 1) / (float) set->capacity;
+    if (load > SET_MAX_LOAD) {
 
-      size_t capacity = set->capacity;
-      ident *elements = set->elements;
+      const size_t capacity = set->capacity;
 
-      set->capacity = set->capacity * SET_GROW_FACTOR;
-      set->count = 0;
+      set->capacity = capacity << 1;
 
-      set->elements = calloc(set->capacity, sizeof(ident));
+      set->elements = realloc(set->elements, set->capacity * sizeof(SetEntry));
       assert(set->elements);
 
+      memset(set->elements + capacity, 0, capacity * sizeof(SetEntry));
+
+      bool *pending = calloc(capacity, sizeof(bool));
+      assert(pending);
+
       for (size_t i = 0; i < capacity; i++) {
+        pending[i] = set->elements[i].obj != NULL;
+      }
+
+      const size_t mask = set->capacity - 1;
+
+      for (size_t i = 0; i < capacity; i++) {
+        if (pending[i]) {
+
+          SetEntry entry = set->elements[i];
+
+          set->elements[i] = (SetEntry) { .obj = NULL };
+          pending[i] = false;
+
+          size_t j = entry.hash & mask;
+          while (true) {
+
+            SetEntry *e = set->elements + j;
+            if (e->obj == NULL) {
+              *e = entry;
+              break;
+            }
+
+            if (j < capacity && pending[j]) {
+              const SetEntry displaced = *e;
+
+              *e = entry;
+              pending[j] = false;
+
+              entry = displaced;
+              j = entry.hash & mask;
+              continue;
+            }
 
-        Array *array = elements[i];
-        if (array) {
-          $(set, addObjectsFromArray, array);
-          release(array);
+            j = (j + 1) & mask;
+          }
         }
       }
 
-      free(elements);
+      free(pending);
     }
   } else {
     $(set, initWithCapacity, SET_DEFAULT_CAPACITY);
@@ -174,17 +338,22 @@ static void addObject_resize(Set *set) {
  */
 static void addObject(Set *self, const ident obj) {
 
+  assert(obj);
+
+  unshare(self);
+
   addObject_resize(self);
 
-  const size_t bin = HashForObject(HASH_SEED, obj) % self->capacity;
+  const size_t hash = hashForObject(obj);
 
-  Array *array = self->elements[bin];
-  if (array == NULL) {
-    array = self->elements[bin] = $(alloc(Array), init);
-  }
+  SetEntry *entry = entryForObject(self, obj, hash);
+  if (entry->obj == NULL) {
+
+    *entry = (SetEntry) {
+      .obj = retain(obj),
+      .hash = hash
+    };
 
-  if ($((Array *) array, containsObject, obj) == false) {
-    $(array, addObject, obj);
     self->count++;
   }
 }
@@ -251,13 +420,8 @@ static Array *allObjects(const Set *self) {
  */
 static bool containsObject(const Set *self, const ident obj) {
 
-  if (self->capacity) {
-    const size_t bin = HashForObject(HASH_SEED, obj) % self->capacity;
-
-    const Array *array = self->elements[bin];
-    if (array) {
-      return $(array, containsObject, obj);
-    }
+  if (self->count) {
+    return entryForObject(self, obj, hashForObject(obj))->obj != NULL;
   }
 
   return false;
@@ -273,13 +437,10 @@ static bool containsObjectMatching(const Set *self, Predicate predicate, ident d
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
-
-      for (size_t j = 0; j < array->count; j++) {
-        if (predicate($(array, objectAtIndex, j), data)) {
-          return true;
-        }
+    const SetEntry *entry = self->elements + i;
+    if (entry->obj) {
+      if (predicate(entry->obj, data)) {
+        return true;
       }
     }
   }
@@ -297,12 +458,9 @@ static void enumerateObjects(const Set *self, SetEnumerator enumerator, ident da
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
-
-      for (size_t j = 0; j < array->count; j++) {
-        enumerator(self, $(array, objectAtIndex, j), data);
-      }
+    const SetEntry *entry = self->elements + i;
+    if (entry->obj) {
+      enumerator(self, entry->obj, data);
     }
   }
 }
@@ -315,21 +473,20 @@ static void filter(Set *self, Predicate predicate, ident data) {
 
   assert(predicate);
 
-  self->count = 0;
+  unshare(self);
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
+    SetEntry *entry = self->elements + i;
+    while (entry->obj && predicate(entry->obj, data) == false) {
 
-      $(array, filter, predicate, data);
+      ident obj = entry->obj;
 
-      if (array->count == 0) {
-        release(array);
-        self->elements[i] = NULL;
-      } else {
-        self->count += array->count;
-      }
+      vacate(self, entry);
+
+      self->count--;
+
+      release(obj);
     }
   }
 }
@@ -346,15 +503,10 @@ static Set *filteredSet(const Set *self, Predicate predicate, ident data) {
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
-
-      for (size_t j = 0; j < array->count; j++) {
-        ident obj = $(array, objectAtIndex, j);
-
-        if (predicate(obj, data)) {
-          $(set, addObject, obj);
-        }
+    const SetEntry *entry = self->elements + i;
+    if (entry->obj) {
+      if (predicate(entry->obj, data)) {
+        $(set, addObject, entry->obj);
       }
     }
   }
@@ -403,10 +555,14 @@ static Set *initWithCapacity(Set *self, size_t capacity) {
   self = (Set *) super(Object, self, init);
   if (self) {
 
-    self->capacity = capacity;
-    if (self->capacity) {
+    if (capacity) {
+
+      self->capacity = 1;
+      while (self->capacity < capacity) {
+        self->capacity <<= 1;
+      }
 
-      self->elements = calloc(self->capacity, sizeof(ident));
+      self->elements = calloc(self->capacity, sizeof(SetEntry));
       assert(self->elements);
     }
   }
@@ -442,13 +598,6 @@ static Set *initWithObjects(Set *self, ...) {
   return self;
 }
 
-/**
- * @brief SetEnumerator for initWithSet.
- */
-static void initWithSet_enumerator(const Set *set, ident obj, ident data) {
-  $((Set *) data, addObject, obj);
-}
-
 /**
  * @fn Set *Set::initWithSet(Set *self, const Set *set)
  * @memberof Set
@@ -458,7 +607,7 @@ static Set *initWithSet(Set *self, const Set *set) {
   self = (Set *) super(Object, self, init);
   if (self) {
     if (set) {
-      $(set, enumerateObjects, initWithSet_enumerator, self);
+      share(self, set);
     }
   }
 
@@ -478,17 +627,14 @@ static Set *mappedSet(const Set *self, Functor functor, ident data) {
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    const Array *array = self->elements[i];
-    if (array) {
-
-      for (size_t j = 0; j < array->count; j++) {
+    const SetEntry *entry = self->elements + i;
+    if (entry->obj) {
 
-        ident obj = functor(array->elements[j], data);
+      ident obj = functor(entry->obj, data);
 
-        $(set, addObject, obj);
+      $(set, addObject, obj);
 
-        release(obj);
-      }
+      release(obj);
     }
   }
 
@@ -505,12 +651,9 @@ static ident reduce(const Set *self, Reducer reducer, ident accumulator, ident d
 
   for (size_t i = 0; i < self->capacity; i++) {
 
-    const Array *array = self->elements[i];
-    if (array) {
-
-      for (size_t j = 0; j < array->count; j++) {
-        accumulator = reducer(array->elements[j], accumulator, data);
-      }
+    const SetEntry *entry = self->elements + i;
+    if (entry->obj) {
+      accumulator = reducer(entry->obj, accumulator, data);
     }
   }
 
@@ -523,12 +666,25 @@ static ident reduce(const Set *self, Reducer reducer, ident accumulator, ident d
  */
 static void removeAllObjects(Set *self) {
 
+  if (self->references) {
+
+    const size_t capacity = self->capacity;
+
+    relinquish(self);
+
+    self->elements = calloc(capacity, sizeof(SetEntry));
+    assert(self->elements);
+
+    self->count = 0;
+    return;
+  }
+
   for (size_t i = 0; i < self->capacity; i++) {
 
-    Array *array = self->elements[i];
-    if (array) {
-      release(array);
-      self->elements[i] = NULL;
+    SetEntry *entry = self->elements + i;
+    if (entry->obj) {
+      release(entry->obj);
+      *entry = (SetEntry) { .obj = NULL };
     }
   }
 
@@ -541,27 +697,22 @@ static void removeAllObjects(Set *self) {
  */
 static void removeObject(Set *self, const ident obj) {
 
-  if (self->capacity == 0) {
+  if (self->count == 0) {
     return;
   }
 
-  const size_t bin = HashForObject(HASH_SEED, obj) % self->capacity;
+  unshare(self);
 
-  Array *array = self->elements[bin];
-  if (array) {
+  SetEntry *entry = entryForObject(self, obj, hashForObject(obj));
+  if (entry->obj) {
 
-    const ssize_t index = $(array, indexOfObject, obj);
-    if (index > -1) {
+    ident member = entry->obj;
 
-      $(array, removeObjectAtIndex, index);
+    vacate(self, entry);
 
-      if (((Array *) array)->count == 0) {
-        release(array);
-        self->elements[bin] = NULL;
-      }
+    self->count--;
 
-      self->count--;
-    }
+    release(member);
   }
 }
 
@@ -47,8 +47,25 @@ typedef struct SetInterface SetInterface;
  */
 typedef void (*SetEnumerator)(const Set *set, ident obj, ident data);
 
+/**
+ * @brief A member of a Set, and its hash.
+ */
+typedef struct {
+
+  /**
+   * @brief The Object, or `NULL` if this entry is vacant.
+   */
+  ident obj;
+
+  /**
+   * @brief The finalized hash of `obj`, so that probing and growing need not recompute it.
+   */
+  size_t hash;
+} SetEntry;
+
 /**
  * @brief Sets.
+ * @details Members are stored inline in a single open-addressed table, probed linearly.
  * @extends Object
  * @ingroup Collections
  */
@@ -66,7 +83,7 @@ struct Set {
   SetInterface *interface;
 
   /**
-   * @brief The internal size (number of bins).
+   * @brief The internal size (number of entries), always a power of two.
    * @private
    */
   size_t capacity;
@@ -77,10 +94,17 @@ struct Set {
   size_t count;
 
   /**
-   * @brief The elements.
+   * @brief The entries.
    * @private
    */
-  ident *elements;
+  SetEntry *elements;
+
+  /**
+   * @brief The number of Sets sharing `elements`, or `NULL` if this Set owns them outright.
+   * @details Copies share their elements until either is mutated, which then copies them.
+   * @private
+   */
+  size_t *references;
 };
 
 
@@ -203,7 +227,7 @@ struct SetInterface {
    * @fn Set *Set::initWithCapacity(Set *self, size_t capacity)
    * @brief Initializes this Set with the specified capacity.
    * @param self The Set.
-   * @param capacity The desired initial capacity.
+   * @param capacity The desired initial capacity, which is rounded up to a power of two.
    * @return The initialized Set, or `NULL` on error.
    * @memberof Set
    */
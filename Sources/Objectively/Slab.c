@@ -0,0 +1,363 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "Config.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Class.h"
+#include "Once.h"
+#include "Slab.h"
+
+/**
+ * @brief Blocks are aligned as `malloc` would align them.
+ */
+#define SLAB_ALIGNMENT 16
+
+/**
+ * @brief The minimum number of blocks carved from each slab.
+ */
+#define SLAB_MIN_BLOCKS 16
+
+/**
+ * @brief The number of blocks a magazine holds.
+ */
+#define SLAB_MAGAZINE_SIZE 64
+
+typedef struct Chunk Chunk;
+typedef struct Magazine Magazine;
+
+/**
+ * @brief The header of a slab, which its blocks follow.
+ */
+struct Chunk {
+  Chunk *next;
+};
+
+/**
+ * @brief A stack of free blocks. Each thread owns one per Slab, and the Slab keeps those that
+ * threads have returned to it in its depot.
+ */
+struct Magazine {
+  Slab *slab;
+  Magazine *next;
+  size_t count;
+  ident blocks[SLAB_MAGAZINE_SIZE];
+};
+
+/**
+ * @brief The magazines of the calling thread, indexed by `Slab::index`.
+ */
+typedef struct {
+  size_t count;
+  Magazine *magazines[];
+} Magazines;
+
+struct Slab {
+
+  /**
+   * @brief The block size, rounded up to `SLAB_ALIGNMENT`.
+   */
+  size_t size;
+
+  /**
+   * @brief The size of each slab, including its header.
+   */
+  size_t slabSize;
+
+  /**
+   * @brief The index of this Slab's magazine in each thread's Magazines.
+   */
+  size_t index;
+
+  /**
+   * @brief Guards everything below. Taken only to exchange blocks with a magazine.
+   */
+  pthread_mutex_t lock;
+
+  /**
+   * @brief The slabs, most recently allocated first.
+   */
+  Chunk *chunks;
+
+  /**
+   * @brief The count of `chunks`, read without `lock` for statistics.
+   */
+  size_t slabs;
+
+  /**
+   * @brief The blocks of the most recent slab that have never been handed out.
+   */
+  uint8_t *cursor, *limit;
+
+  /**
+   * @brief Magazines returned by threads, none of them empty.
+   */
+  Magazine *depot;
+};
+
+/**
+ * @brief The next `Slab::index`.
+ */
+static size_t _index;
+
+/**
+ * @brief The magazines of the calling thread, also registered with `_magazinesKey` so that
+ * they are returned to their Slabs when the thread exits.
+ */
+static __thread Magazines *_magazines;
+
+static pthread_key_t _magazinesKey;
+
+/**
+ * @brief Pushes a nonempty magazine into its Slab's depot.
+ */
+static void pushMagazine(Slab *slab, Magazine *magazine) {
+
+  pthread_mutex_lock(&slab->lock);
+
+  magazine->next = slab->depot;
+  slab->depot = magazine;
+
+  pthread_mutex_unlock(&slab->lock);
+}
+
+/**
+ * @brief Returns an exiting thread's blocks to their Slabs, where other threads can reach them.
+ */
+static void destroyMagazines(ident data) {
+
+  Magazines *magazines = data;
+
+  for (size_t i = 0; i < magazines->count; i++) {
+    Magazine *magazine = magazines->magazines[i];
+    if (magazine) {
+      if (magazine->count) {
+        pushMagazine(magazine->slab, magazine);
+      } else {
+        free(magazine);
+      }
+    }
+  }
+
+  free(magazines);
+}
+
+/**
+ * @return The calling thread's magazine for the given Slab.
+ */
+static inline Magazine *magazine(Slab *slab) {
+
+  Magazines *magazines = _magazines;
+  if (magazines == NULL || slab->index >= magazines->count) {
+
+    const size_t count = __atomic_load_n(&_index, __ATOMIC_RELAXED);
+    assert(slab->index < count);
+
+    const size_t oldCount = magazines ? magazines->count : 0;
+
+    magazines = realloc(magazines, sizeof(Magazines) + count * sizeof(Magazine *));
+    assert(magazines);
+
+    memset(magazines->magazines + oldCount, 0, (count - oldCount) * sizeof(Magazine *));
+    magazines->count = count;
+
+    _magazines = magazines;
+    pthread_setspecific(_magazinesKey, magazines);
+  }
+
+  Magazine *magazine = magazines->magazines[slab->index];
+  if (magazine == NULL) {
+    magazine = magazines->magazines[slab->index] = calloc(1, sizeof(Magazine));
+    assert(magazine);
+
+    magazine->slab = slab;
+  }
+
+  return magazine;
+}
+
+/**
+ * @brief Refills an empty magazine, from the depot if it can, and otherwise from the slabs.
+ */
+static void refill(Slab *slab, Magazine *magazine) {
+
+  pthread_mutex_lock(&slab->lock);
+
+  Magazine *full = slab->depot;
+  if (full) {
+    slab->depot = full->next;
+  } else {
+    while (magazine->count < SLAB_MAGAZINE_SIZE / 2) {
+
+      if (slab->cursor == slab->limit) {
+
+        Chunk *chunk = malloc(slab->slabSize);
+        assert(chunk);
+
+        chunk->next = slab->chunks;
+        slab->chunks = chunk;
+
+        __atomic_add_fetch(&slab->slabs, 1, __ATOMIC_RELAXED);
+
+        slab->cursor = (uint8_t *) chunk + SLAB_ALIGNMENT;
+        slab->limit = (uint8_t *) chunk + slab->slabSize;
+      }
+
+      magazine->blocks[magazine->count++] = slab->cursor;
+      slab->cursor += slab->size;
+    }
+  }
+
+  pthread_mutex_unlock(&slab->lock);
+
+  if (full) {
+    memcpy(magazine->blocks, full->blocks, full->count * sizeof(ident));
+    magazine->count = full->count;
+
+    free(full);
+  }
+}
+
+/**
+ * @brief Moves the older half of a full magazine to the depot. Keeping the other half means a
+ * thread that alternates between allocating and freeing does not return here every time.
+ */
+static void flush(Slab *slab, Magazine *magazine) {
+
+  Magazine *half = malloc(sizeof(Magazine));
+  assert(half);
+
+  half->slab = slab;
+  half->count = SLAB_MAGAZINE_SIZE / 2;
+  memcpy(half->blocks, magazine->blocks, half->count * sizeof(ident));
+
+  magazine->count -= half->count;
+  memmove(magazine->blocks, magazine->blocks + half->count, magazine->count * sizeof(ident));
+
+  pushMagazine(slab, half);
+}
+
+/**
+ * @brief Creates the key that returns each thread's magazines when it exits.
+ */
+static void setup(void) {
+
+  const int err = pthread_key_create(&_magazinesKey, destroyMagazines);
+  assert(err == 0);
+}
+
+Slab *SlabCreate(size_t size) {
+
+  static Once once;
+  do_once(&once, setup());
+
+  assert(size);
+
+  Slab *slab = calloc(1, sizeof(Slab));
+  assert(slab);
+
+  slab->size = (size + SLAB_ALIGNMENT - 1) & ~(SLAB_ALIGNMENT - 1);
+
+  const size_t pageSize = _pageSize ?: 4096;
+  const size_t blocks = max((pageSize - SLAB_ALIGNMENT) / slab->size, (size_t) SLAB_MIN_BLOCKS);
+
+  slab->slabSize = SLAB_ALIGNMENT + blocks * slab->size;
+  slab->index = __atomic_fetch_add(&_index, 1, __ATOMIC_RELAXED);
+
+  pthread_mutex_init(&slab->lock, NULL);
+
+  return slab;
+}
+
+void SlabDestroy(Slab *slab) {
+
+  if (slab) {
+
+    Chunk *chunk = slab->chunks;
+    while (chunk) {
+      Chunk *next = chunk->next;
+      free(chunk);
+      chunk = next;
+    }
+
+    Magazine *magazine = slab->depot;
+    while (magazine) {
+      Magazine *next = magazine->next;
+      free(magazine);
+      magazine = next;
+    }
+
+    /* Only the calling thread's magazine can be reached from here. Any other thread still
+     * holding one is holding blocks that no longer exist. */
+    Magazines *magazines = _magazines;
+    if (magazines && slab->index < magazines->count) {
+      free(magazines->magazines[slab->index]);
+      magazines->magazines[slab->index] = NULL;
+    }
+
+    pthread_mutex_destroy(&slab->lock);
+
+    free(slab);
+  }
+}
+
+ident SlabAlloc(Slab *slab) {
+
+  Magazine *mag = magazine(slab);
+  if (mag->count == 0) {
+    refill(slab, mag);
+  }
+
+  ident mem = mag->blocks[--mag->count];
+
+  memset(mem, 0, slab->size);
+  return mem;
+}
+
+void SlabFree(Slab *slab, ident mem) {
+
+  assert(mem);
+
+  Magazine *mag = magazine(slab);
+  if (mag->count == SLAB_MAGAZINE_SIZE) {
+    flush(slab, mag);
+  }
+
+  mag->blocks[mag->count++] = mem;
+}
+
+SlabStats SlabGetStats(const Slab *slab) {
+
+  SlabStats stats = { 0 };
+
+  if (slab) {
+    stats.slabs = __atomic_load_n(&slab->slabs, __ATOMIC_RELAXED);
+    stats.bytes = stats.slabs * slab->slabSize;
+  }
+
+  return stats;
+}
@@ -0,0 +1,88 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#pragma once
+
+#include <Objectively/Types.h>
+
+/**
+ * @file
+ * @brief Slab allocation for fixed-size instances.
+ * @details A Slab hands out blocks of a single size, carved from page-sized slabs. Each thread
+ * caches freed blocks in a magazine of its own, so that allocating and freeing never contend
+ * with other threads until a magazine runs empty or overflows.
+ * @remarks Objectively backs each Class with a Slab when the environment variable
+ * `OBJECTIVELY_ALLOCATOR` is set to `slab`.
+ * @ingroup Core
+ */
+
+typedef struct Slab Slab;
+
+/**
+ * @brief Slab statistics.
+ */
+typedef struct {
+
+  /**
+   * @brief The number of slabs in use.
+   */
+  size_t slabs;
+
+  /**
+   * @brief The number of bytes retained by those slabs.
+   */
+  size_t bytes;
+} SlabStats;
+
+/**
+ * @brief Creates a Slab for blocks of the given size.
+ * @param size The block size, in bytes.
+ * @return The Slab.
+ */
+OBJECTIVELY_EXPORT Slab *SlabCreate(size_t size);
+
+/**
+ * @brief Destroys the given Slab, and every block allocated from it.
+ * @param slab The Slab.
+ */
+OBJECTIVELY_EXPORT void SlabDestroy(Slab *slab);
+
+/**
+ * @brief Allocates a zero-filled block from the given Slab.
+ * @param slab The Slab.
+ * @return The block.
+ */
+OBJECTIVELY_EXPORT ident SlabAlloc(Slab *slab);
+
+/**
+ * @brief Returns a block to the Slab it was allocated from.
+ * @param slab The Slab.
+ * @param mem The block.
+ */
+OBJECTIVELY_EXPORT void SlabFree(Slab *slab, ident mem);
+
+/**
+ * @param slab The Slab, which may be `NULL`.
+ * @return The statistics for the given Slab.
+ */
+OBJECTIVELY_EXPORT SlabStats SlabGetStats(const Slab *slab);
@@ -0,0 +1,316 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Hash.h"
+#include "Slice.h"
+
+#define _Class _Slice
+
+#pragma mark - Object
+
+/**
+ * @see Object::copy(const Object *)
+ */
+static Object *copy(const Object *self) {
+
+  const Slice *this = (Slice *) self;
+
+  return (Object *) $(this, slice, (const Range) { 0, this->range.length });
+}
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+  Slice *this = (Slice *) self;
+
+  release((ident) this->parent);
+
+  super(Object, self, dealloc);
+}
+
+/**
+ * @see Object::description(const Object *)
+ */
+static String *description(const Object *self) {
+
+  const Slice *this = (Slice *) self;
+
+  if ($(this->parent, isKindOfClass, _String())) {
+    return $(this, string);
+  }
+
+  return str("%s@%p [%zd, %zu] of %s@%p", classnameof(self), self,
+             this->range.location, this->range.length,
+             classnameof(this->parent), this->parent);
+}
+
+/**
+ * @see Object::hash(const Object *)
+ */
+static int hash(const Object *self) {
+
+  const Slice *this = (Slice *) self;
+
+  return (int) Hash64ForBytes(Hash64Seed(), $(this, bytes), this->range.length);
+}
+
+/**
+ * @return The bytes and length of `obj`, if it is a String, Data or Slice of the same kind as
+ * `parent`, or `NULL`.
+ */
+static const uint8_t *bytesOfKind(const Object *parent, const Object *obj, size_t *length) {
+
+  const bool string = $(parent, isKindOfClass, _String());
+
+  if ($(obj, isKindOfClass, _Slice())) {
+
+    const Slice *that = (Slice *) obj;
+    if ($(that->parent, isKindOfClass, _String()) == string) {
+      *length = that->range.length;
+      return $(that, bytes);
+    }
+
+  } else if (string) {
+
+    if ($(obj, isKindOfClass, _String())) {
+      *length = ((String *) obj)->length;
+      return (uint8_t *) ((String *) obj)->chars;
+    }
+
+  } else if ($(obj, isKindOfClass, _Data())) {
+    *length = ((Data *) obj)->length;
+    return ((Data *) obj)->bytes;
+  }
+
+  return NULL;
+}
+
+/**
+ * @see Object::isEqual(const Object *, const Object *)
+ * @remarks A Slice is equal to any String or Data, or Slice of either, of the same kind as its
+ * parent, with the same bytes.
+ */
+static bool isEqual(const Object *self, const Object *other) {
+
+  if (super(Object, self, isEqual, other)) {
+    return true;
+  }
+
+  if (other) {
+
+    const Slice *this = (Slice *) self;
+
+    size_t length;
+    const uint8_t *bytes = bytesOfKind(this->parent, other, &length);
+
+    if (bytes && length == this->range.length) {
+      return length == 0 || memcmp($(this, bytes), bytes, length) == 0;
+    }
+  }
+
+  return false;
+}
+
+#pragma mark - Slice
+
+/**
+ * @fn const uint8_t *Slice::bytes(const Slice *self)
+ * @memberof Slice
+ */
+static const uint8_t *bytes(const Slice *self) {
+
+  if ($(self->parent, isKindOfClass, _String())) {
+    return (uint8_t *) ((String *) self->parent)->chars + self->range.location;
+  } else {
+    return ((Data *) self->parent)->bytes + self->range.location;
+  }
+}
+
+/**
+ * @fn Data *Slice::data(const Slice *self)
+ * @memberof Slice
+ */
+static Data *data(const Slice *self) {
+  return $$(Data, dataWithBytes, $(self, bytes), self->range.length);
+}
+
+/**
+ * @brief Initializes the given Slice with `parent`, which it retains.
+ */
+static Slice *initWithParent(Slice *self, const Object *parent, const Range range) {
+
+  self = (Slice *) super(Object, self, init);
+  if (self) {
+    self->parent = retain((ident) parent);
+    self->range = range;
+  }
+
+  return self;
+}
+
+/**
+ * @fn Slice *Slice::initWithData(Slice *self, const Data *data, const Range range)
+ * @memberof Slice
+ */
+static Slice *initWithData(Slice *self, const Data *data, const Range range) {
+
+  assert(data);
+  assert(range.location >= 0);
+  assert(range.location + range.length <= data->length);
+
+  return initWithParent(self, (Object *) data, range);
+}
+
+/**
+ * @fn Slice *Slice::initWithSlice(Slice *self, const Slice *slice, const Range range)
+ * @memberof Slice
+ */
+static Slice *initWithSlice(Slice *self, const Slice *slice, const Range range) {
+
+  assert(slice);
+  assert(range.location >= 0);
+  assert(range.location + range.length <= slice->range.length);
+
+  const Range parentRange = {
+    .location = slice->range.location + range.location,
+    .length = range.length
+  };
+
+  return initWithParent(self, slice->parent, parentRange);
+}
+
+/**
+ * @fn Slice *Slice::initWithString(Slice *self, const String *string, const Range range)
+ * @memberof Slice
+ */
+static Slice *initWithString(Slice *self, const String *string, const Range range) {
+
+  assert(string);
+  assert(range.location >= 0);
+  assert(range.location + range.length <= string->length);
+
+  return initWithParent(self, (Object *) string, range);
+}
+
+/**
+ * @fn Slice *Slice::slice(const Slice *self, const Range range)
+ * @memberof Slice
+ */
+static Slice *slice(const Slice *self, const Range range) {
+  return $(alloc(Slice), initWithSlice, self, range);
+}
+
+/**
+ * @fn String *Slice::string(const Slice *self)
+ * @memberof Slice
+ */
+static String *string(const Slice *self) {
+
+  const size_t length = self->range.length;
+
+  String *string = $(alloc(String), initWithCapacity, length + 1);
+  assert(string);
+
+  memcpy(string->chars, $(self, bytes), length);
+  string->chars[length] = '\0';
+  string->length = length;
+
+  return string;
+}
+
+/**
+ * @fn Slice *Slice::trimmedSlice(const Slice *self)
+ * @memberof Slice
+ */
+static Slice *trimmedSlice(const Slice *self) {
+
+  const uint8_t *bytes = $(self, bytes);
+
+  Range range = { .location = 0, .length = self->range.length };
+
+  while (range.length > 0 && isspace(bytes[range.location])) {
+    range.location++;
+    range.length--;
+  }
+
+  while (range.length > 0 && isspace(bytes[range.location + range.length - 1])) {
+    range.length--;
+  }
+
+  return $(self, slice, range);
+}
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+  ((ObjectInterface *) clazz->interface)->copy = copy;
+  ((ObjectInterface *) clazz->interface)->dealloc = dealloc;
+  ((ObjectInterface *) clazz->interface)->description = description;
+  ((ObjectInterface *) clazz->interface)->hash = hash;
+  ((ObjectInterface *) clazz->interface)->isEqual = isEqual;
+
+  ((SliceInterface *) clazz->interface)->bytes = bytes;
+  ((SliceInterface *) clazz->interface)->data = data;
+  ((SliceInterface *) clazz->interface)->initWithData = initWithData;
+  ((SliceInterface *) clazz->interface)->initWithSlice = initWithSlice;
+  ((SliceInterface *) clazz->interface)->initWithString = initWithString;
+  ((SliceInterface *) clazz->interface)->slice = slice;
+  ((SliceInterface *) clazz->interface)->string = string;
+  ((SliceInterface *) clazz->interface)->trimmedSlice = trimmedSlice;
+}
+
+/**
+ * @fn Class *Slice::_Slice(void)
+ * @memberof Slice
+ */
+Class *_Slice(void) {
+  static Class *clazz;
+  static Once once;
+
+  do_once(&once, {
+    clazz = _initialize(&(const ClassDef) {
+      .name = "Slice",
+      .superclass = _Object(),
+      .instanceSize = sizeof(Slice),
+      .interfaceOffset = offsetof(Slice, interface),
+      .interfaceSize = sizeof(SliceInterface),
+      .initialize = initialize,
+    });
+  });
+
+  return clazz;
+}
+
+#undef _Class
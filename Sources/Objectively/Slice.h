@@ -0,0 +1,167 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <Objectively/String.h>
+
+/**
+ * @file
+ * @brief Views of a range of a String or Data, which share its storage.
+ */
+
+typedef struct SliceInterface SliceInterface;
+
+/**
+ * @brief Views of a range of a String or Data, which share its storage.
+ * @details A Slice retains its parent, and references its bytes in place, so that tokenizing or
+ * parsing a large String allocates a Slice for each token rather than a copy of its bytes.
+ * @details A Slice is equal to any String, or to any Slice of a String, with the same bytes, and
+ * it hashes as such a String does. The same holds for Data. So a Slice may be used to look up a
+ * Dictionary or Set keyed by Strings or Data.
+ * @remarks The bytes of a Slice are resolved through its parent, so a Slice remains valid if its
+ * parent reallocates. Its contents change with its parent's, however, and its parent MUST NOT be
+ * truncated short of its range.
+ * @remarks Because a Slice is not null-terminated, its bytes must not be treated as a C string.
+ * @extends Object
+ * @ingroup ByteStreams
+ */
+struct Slice {
+
+  /**
+   * @brief The superclass.
+   */
+  Object object;
+
+  /**
+   * @brief The interface.
+   * @protected
+   */
+  SliceInterface *interface;
+
+  /**
+   * @brief The String or Data that this Slice views.
+   */
+  const Object *parent;
+
+  /**
+   * @brief The range of `parent`, in bytes.
+   */
+  Range range;
+};
+
+/**
+ * @brief The Slice interface.
+ */
+struct SliceInterface {
+
+  /**
+   * @brief The superclass interface.
+   */
+  ObjectInterface objectInterface;
+
+  /**
+   * @fn const uint8_t *Slice::bytes(const Slice *self)
+   * @param self The Slice.
+   * @return The first byte of this Slice, within the storage of its parent.
+   * @remarks The returned pointer is invalidated by any mutation of the parent.
+   * @memberof Slice
+   */
+  const uint8_t *(*bytes)(const Slice *self);
+
+  /**
+   * @fn Data *Slice::data(const Slice *self)
+   * @param self The Slice.
+   * @return A new Data with a copy of the bytes of this Slice.
+   * @memberof Slice
+   */
+  Data *(*data)(const Slice *self);
+
+  /**
+   * @fn Slice *Slice::initWithData(Slice *self, const Data *data, const Range range)
+   * @brief Initializes this Slice with the given range of `data`.
+   * @param self The Slice.
+   * @param data The Data.
+   * @param range The range of `data`, in bytes.
+   * @return The initialized Slice, or `NULL` on error.
+   * @memberof Slice
+   */
+  Slice *(*initWithData)(Slice *self, const Data *data, const Range range);
+
+  /**
+   * @fn Slice *Slice::initWithSlice(Slice *self, const Slice *slice, const Range range)
+   * @brief Initializes this Slice with the given range of `slice`.
+   * @param self The Slice.
+   * @param slice The Slice.
+   * @param range The range of `slice`, in bytes.
+   * @return The initialized Slice, or `NULL` on error.
+   * @remarks The initialized Slice views the parent of `slice` directly.
+   * @memberof Slice
+   */
+  Slice *(*initWithSlice)(Slice *self, const Slice *slice, const Range range);
+
+  /**
+   * @fn Slice *Slice::initWithString(Slice *self, const String *string, const Range range)
+   * @brief Initializes this Slice with the given range of `string`.
+   * @param self The Slice.
+   * @param string The String.
+   * @param range The range of `string`, in bytes.
+   * @return The initialized Slice, or `NULL` on error.
+   * @memberof Slice
+   */
+  Slice *(*initWithString)(Slice *self, const String *string, const Range range);
+
+  /**
+   * @fn Slice *Slice::slice(const Slice *self, const Range range)
+   * @param self The Slice.
+   * @param range The range of this Slice, in bytes.
+   * @return A new Slice of the given range of this Slice.
+   * @memberof Slice
+   */
+  Slice *(*slice)(const Slice *self, const Range range);
+
+  /**
+   * @fn String *Slice::string(const Slice *self)
+   * @param self The Slice.
+   * @return A new String with a copy of the bytes of this Slice, which are assumed to be UTF-8.
+   * @memberof Slice
+   */
+  String *(*string)(const Slice *self);
+
+  /**
+   * @fn Slice *Slice::trimmedSlice(const Slice *self)
+   * @param self The Slice.
+   * @return A new Slice of this Slice, with leading and trailing whitespace excluded.
+   * @memberof Slice
+   */
+  Slice *(*trimmedSlice)(const Slice *self);
+};
+
+/**
+ * @fn Class *Slice::_Slice(void)
+ * @brief The Slice archetype.
+ * @return The Slice Class.
+ * @memberof Slice
+ */
+OBJECTIVELY_EXPORT Class *_Slice(void);
@@ -25,13 +25,22 @@
 
 #include <assert.h>
 #include <iconv.h>
+#include <pthread.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <wchar.h>
+#include <wctype.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 #include "Hash.h"
+#include "Slice.h"
 #include "String.h"
 
 #if defined(__MINGW32__)
@@ -61,7 +70,9 @@ static void dealloc(Object *self) {
 
   String *this = (String *) self;
 
-  free(this->chars);
+  if (this->chars != this->storage) {
+    free(this->chars);
+  }
 
   super(Object, self, dealloc);
 }
@@ -81,7 +92,13 @@ static int hash(const Object *self) {
 
   String *this = (String *) self;
 
-  return HashForCString(HASH_SEED, this->chars);
+  int hash = __atomic_load_n(&this->hash, __ATOMIC_RELAXED);
+  if (hash == 0) {
+    hash = (int) Hash64ForBytes(Hash64Seed(), this->chars, this->length);
+    __atomic_store_n(&this->hash, hash, __ATOMIC_RELAXED);
+  }
+
+  return hash;
 }
 
 /**
@@ -93,11 +110,19 @@ static bool isEqual(const Object *self, const Object *other) {
     return true;
   }
 
+  if (other && $(other, isKindOfClass, _Slice())) {
+    return $(other, isEqual, self);
+  }
+
   if (other && $(other, isKindOfClass, _String())) {
 
     const String *this = (String *) self;
     const String *that = (String *) other;
 
+    if (this->interned && that->interned) {
+      return false;
+    }
+
     if (this->length == that->length) {
 
       const Range range = { 0, this->length };
@@ -111,8 +136,88 @@ static bool isEqual(const Object *self, const Object *other) {
 #pragma mark - String
 
 /**
- * @brief Character transcoding context for `iconv`.
- * @see iconv(3)
+ * @brief The number of StringEncodings, for tables indexed by them.
+ */
+#define STRING_ENCODING_COUNT (STRING_ENCODING_WCHAR + 1)
+
+/**
+ * @brief The `iconv` descriptors of a thread, indexed by destination and source StringEncoding.
+ */
+typedef struct {
+  iconv_t descriptors[STRING_ENCODING_COUNT][STRING_ENCODING_COUNT];
+} Descriptors;
+
+/**
+ * @brief The descriptors of the calling thread, also registered with `_descriptorsKey` so that
+ * they are closed when the thread exits.
+ */
+static __thread Descriptors *_descriptors;
+
+static pthread_key_t _descriptorsKey;
+
+/**
+ * @brief The `pthread_key_t` destructor, closing an exiting thread's descriptors.
+ */
+static void closeDescriptors(ident data) {
+
+  Descriptors *descriptors = data;
+
+  for (size_t i = 0; i < STRING_ENCODING_COUNT; i++) {
+    for (size_t j = 0; j < STRING_ENCODING_COUNT; j++) {
+      if (descriptors->descriptors[i][j]) {
+        iconv_close(descriptors->descriptors[i][j]);
+      }
+    }
+  }
+
+  free(descriptors);
+}
+
+/**
+ * @brief Creates the key that closes each thread's descriptors when it exits.
+ */
+static void setupDescriptors(void) {
+
+  const int err = pthread_key_create(&_descriptorsKey, closeDescriptors);
+  assert(err == 0);
+}
+
+/**
+ * @return The calling thread's `iconv` descriptor from one StringEncoding to another, reset to
+ * its initial shift state.
+ * @remarks Opening a descriptor loads the conversion tables, which costs far more than converting
+ * a typical String, so each thread opens each conversion only once.
+ */
+static iconv_t descriptor(StringEncoding to, StringEncoding from) {
+
+  Descriptors *descriptors = _descriptors;
+  if (descriptors == NULL) {
+
+    static Once once;
+    do_once(&once, setupDescriptors());
+
+    descriptors = calloc(1, sizeof(Descriptors));
+    assert(descriptors);
+
+    _descriptors = descriptors;
+    pthread_setspecific(_descriptorsKey, descriptors);
+  }
+
+  iconv_t cd = descriptors->descriptors[to][from];
+  if (cd == NULL) {
+    cd = iconv_open(NameForStringEncoding(to), NameForStringEncoding(from));
+    assert(cd != (iconv_t) -1);
+
+    descriptors->descriptors[to][from] = cd;
+  } else {
+    iconv(cd, NULL, NULL, NULL, NULL);
+  }
+
+  return cd;
+}
+
+/**
+ * @brief Character transcoding context.
  */
 typedef struct {
   StringEncoding to;
@@ -124,7 +229,298 @@ typedef struct {
 } Transcode;
 
 /**
- * @brief Transcodes input from one character encoding to another via `iconv`.
+ * @return True if the given StringEncoding is transcoded without `iconv`.
+ */
+static inline bool isNative(StringEncoding encoding) {
+
+  switch (encoding) {
+    case STRING_ENCODING_ASCII:
+    case STRING_ENCODING_LATIN1:
+    case STRING_ENCODING_UTF16:
+    case STRING_ENCODING_UTF32:
+    case STRING_ENCODING_UTF8:
+    case STRING_ENCODING_WCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Decodes the code point at the head of UTF-8 input.
+ * @param in The input.
+ * @param length The length of `in`, in bytes.
+ * @param codepoint The decoded code point.
+ * @return The number of bytes decoded, or `0` if the input is malformed.
+ */
+static inline size_t decodeUTF8(const uint8_t *in, size_t length, uint32_t *codepoint) {
+
+  const uint8_t c = in[0];
+  if (c < 0x80) {
+    *codepoint = c;
+    return 1;
+  }
+
+  size_t len;
+  uint32_t min;
+
+  if ((c & 0xe0) == 0xc0) {
+    len = 2, min = 0x80, *codepoint = c & 0x1f;
+  } else if ((c & 0xf0) == 0xe0) {
+    len = 3, min = 0x800, *codepoint = c & 0x0f;
+  } else if ((c & 0xf8) == 0xf0) {
+    len = 4, min = 0x10000, *codepoint = c & 0x07;
+  } else {
+    return 0;
+  }
+
+  if (len > length) {
+    return 0;
+  }
+
+  for (size_t i = 1; i < len; i++) {
+    if ((in[i] & 0xc0) != 0x80) {
+      return 0;
+    }
+    *codepoint = (*codepoint << 6) | (in[i] & 0x3f);
+  }
+
+  if (*codepoint < min || *codepoint > 0x10ffff || (*codepoint >= 0xd800 && *codepoint <= 0xdfff)) {
+    return 0;
+  }
+
+  return len;
+}
+
+/**
+ * @brief Encodes a code point as UTF-8.
+ * @param codepoint The code point.
+ * @param out The output, with room for at least four bytes, or `NULL` to only measure.
+ * @return The number of bytes encoded.
+ */
+static inline size_t encodeUTF8(uint32_t codepoint, uint8_t *out) {
+
+  if (codepoint < 0x80) {
+    if (out) {
+      out[0] = codepoint;
+    }
+    return 1;
+  } else if (codepoint < 0x800) {
+    if (out) {
+      out[0] = 0xc0 | (codepoint >> 6);
+      out[1] = 0x80 | (codepoint & 0x3f);
+    }
+    return 2;
+  } else if (codepoint < 0x10000) {
+    if (out) {
+      out[0] = 0xe0 | (codepoint >> 12);
+      out[1] = 0x80 | ((codepoint >> 6) & 0x3f);
+      out[2] = 0x80 | (codepoint & 0x3f);
+    }
+    return 3;
+  } else {
+    if (out) {
+      out[0] = 0xf0 | (codepoint >> 18);
+      out[1] = 0x80 | ((codepoint >> 12) & 0x3f);
+      out[2] = 0x80 | ((codepoint >> 6) & 0x3f);
+      out[3] = 0x80 | (codepoint & 0x3f);
+    }
+    return 4;
+  }
+}
+
+/**
+ * @return The width, in bytes, of a code unit of the given native StringEncoding.
+ */
+static inline size_t codeUnitWidth(StringEncoding encoding) {
+
+  switch (encoding) {
+    case STRING_ENCODING_UTF16:
+      return 2;
+    case STRING_ENCODING_UTF32:
+      return 4;
+    case STRING_ENCODING_WCHAR:
+      return sizeof(wchar_t);
+    default:
+      return 1;
+  }
+}
+
+/**
+ * @return The code unit at `in`, of the given width and byte order.
+ */
+static inline uint32_t readCodeUnit(const uint8_t *in, size_t width, bool swap) {
+
+  if (width == 2) {
+    uint16_t unit;
+    memcpy(&unit, in, sizeof(unit));
+    return swap ? (uint16_t) ((unit >> 8) | (unit << 8)) : unit;
+  } else {
+    uint32_t unit;
+    memcpy(&unit, in, sizeof(unit));
+    return swap ? __builtin_bswap32(unit) : unit;
+  }
+}
+
+/**
+ * @brief Writes a code unit of the given width, in native byte order.
+ */
+static inline void writeCodeUnit(uint32_t unit, size_t width, uint8_t *out) {
+
+  if (width == 2) {
+    const uint16_t u = unit;
+    memcpy(out, &u, sizeof(u));
+  } else {
+    memcpy(out, &unit, sizeof(unit));
+  }
+}
+
+/**
+ * @brief Transcodes between native StringEncodings, one code point at a time.
+ * @details Nonempty UTF-16 and UTF-32 output begins with a byte order mark, in native byte order.
+ * Input in those encodings honors a leading byte order mark, and is otherwise assumed native.
+ * `STRING_ENCODING_WCHAR` is native `wchar_t`, without a byte order mark. This matches `iconv`.
+ * @param trans A Transcode struct, whose `out` may be `NULL` to only measure the output.
+ * @return The number of bytes written to `trans->out`.
+ */
+static size_t transcodeNative(const Transcode *trans) {
+
+  const uint8_t *in = (const uint8_t *) trans->in;
+  const uint8_t *end = in + trans->length;
+
+  uint8_t *out = (uint8_t *) trans->out;
+  size_t size = 0;
+
+  if (trans->from == trans->to && (trans->from == STRING_ENCODING_UTF8 || trans->from == STRING_ENCODING_ASCII)) {
+    if (out) {
+      memcpy(out, in, trans->length);
+    }
+    return trans->length;
+  }
+
+  const size_t inWidth = codeUnitWidth(trans->from);
+  const size_t outWidth = codeUnitWidth(trans->to);
+
+  bool swap = false;
+  if (trans->from == STRING_ENCODING_UTF16 && end - in >= 2) {
+    if ((in[0] == 0xff && in[1] == 0xfe) || (in[0] == 0xfe && in[1] == 0xff)) {
+      swap = readCodeUnit(in, 2, false) != 0xfeff;
+      in += 2;
+    }
+  } else if (trans->from == STRING_ENCODING_UTF32 && end - in >= 4) {
+    const uint32_t bom = readCodeUnit(in, 4, false);
+    if (bom == 0xfeff || bom == 0xfffe0000) {
+      swap = bom != 0xfeff;
+      in += 4;
+    }
+  }
+
+  if ((trans->to == STRING_ENCODING_UTF16 || trans->to == STRING_ENCODING_UTF32) && in < end) {
+    if (out) {
+      writeCodeUnit(0xfeff, outWidth, out);
+    }
+    size += outWidth;
+  }
+
+  while (in < end) {
+
+    uint32_t codepoint;
+    size_t len;
+
+    switch (trans->from) {
+      case STRING_ENCODING_ASCII:
+        codepoint = *in, len = codepoint < 0x80;
+        break;
+      case STRING_ENCODING_LATIN1:
+        codepoint = *in, len = 1;
+        break;
+      case STRING_ENCODING_UTF8:
+        len = decodeUTF8(in, end - in, &codepoint);
+        break;
+      default:
+        len = 0;
+        if ((size_t) (end - in) >= inWidth) {
+          codepoint = readCodeUnit(in, inWidth, swap), len = inWidth;
+          if (inWidth == 2 && codepoint >= 0xd800 && codepoint <= 0xdfff) {
+            len = 0;
+            if (codepoint < 0xdc00 && end - in >= 4) {
+              const uint32_t low = readCodeUnit(in + 2, 2, swap);
+              if (low >= 0xdc00 && low <= 0xdfff) {
+                codepoint = 0x10000 + ((codepoint - 0xd800) << 10) + (low - 0xdc00), len = 4;
+              }
+            }
+          } else if (codepoint > 0x10ffff || (codepoint >= 0xd800 && codepoint <= 0xdfff)) {
+            len = 0;
+          }
+        }
+        break;
+    }
+
+    assert(len);
+    if (len == 0) {
+      break;
+    }
+
+    switch (trans->to) {
+      case STRING_ENCODING_ASCII:
+      case STRING_ENCODING_LATIN1:
+        assert(codepoint < (trans->to == STRING_ENCODING_ASCII ? 0x80u : 0x100u));
+        if (out) {
+          out[size] = codepoint;
+        }
+        size++;
+        break;
+      case STRING_ENCODING_UTF8:
+        size += encodeUTF8(codepoint, out ? out + size : NULL);
+        break;
+      default:
+        if (outWidth == 2 && codepoint >= 0x10000) {
+          if (out) {
+            writeCodeUnit(0xd800 + ((codepoint - 0x10000) >> 10), 2, out + size);
+            writeCodeUnit(0xdc00 + ((codepoint - 0x10000) & 0x3ff), 2, out + size + 2);
+          }
+          size += 4;
+        } else {
+          if (out) {
+            writeCodeUnit(codepoint, outWidth, out + size);
+          }
+          size += outWidth;
+        }
+        break;
+    }
+
+    in += len;
+  }
+
+  return size;
+}
+
+/**
+ * @return The size, in bytes, of the output of the given Transcode.
+ * @remarks Native transcoding is measured exactly. Otherwise, `iconv` is used only between UTF-8
+ * and the single-byte encodings, whose code points all lie within the Basic Multilingual Plane,
+ * and the size is bounded accordingly.
+ */
+static size_t transcodedSize(const Transcode *trans) {
+
+  if (isNative(trans->to) && isNative(trans->from)) {
+    return transcodeNative(&(const Transcode) {
+      .to = trans->to,
+      .from = trans->from,
+      .in = trans->in,
+      .length = trans->length,
+    });
+  }
+
+  assert(trans->to == STRING_ENCODING_UTF8 || trans->from == STRING_ENCODING_UTF8);
+
+  return trans->to == STRING_ENCODING_UTF8 ? trans->length * 3 : trans->length;
+}
+
+/**
+ * @brief Transcodes input from one character encoding to another.
+ * @details The common encodings are transcoded natively; the rest through the calling thread's
+ * cached `iconv` descriptor.
  * @param trans A Transcode struct.
  * @return The number of bytes written to `trans->out`.
  */
@@ -133,11 +529,15 @@ static size_t transcode(Transcode *trans) {
   assert(trans);
   assert(trans->to);
   assert(trans->from);
-  assert(trans->out);
-  assert(trans->size);
+  assert(trans->out || trans->size == 0);
+
+  if (isNative(trans->to) && isNative(trans->from)) {
+    const size_t size = transcodeNative(trans);
+    assert(size <= trans->size);
+    return size;
+  }
 
-  iconv_t cd = iconv_open(NameForStringEncoding(trans->to), NameForStringEncoding(trans->from));
-  assert(cd != (iconv_t) -1);
+  iconv_t cd = descriptor(trans->to, trans->from);
 
   char *in = trans->in;
   char *out = trans->out;
@@ -148,9 +548,6 @@ static size_t transcode(Transcode *trans) {
   const size_t ret = iconv(cd, &in, &inBytesRemaining, &out, &outBytesRemaining);
   assert(ret != (size_t) -1);
 
-  int err = iconv_close(cd);
-  assert(err == 0);
-
   return trans->size - outBytesRemaining;
 }
 
@@ -176,10 +573,10 @@ static Order compareTo(const String *self, const String *other, const Range rang
 }
 
 /**
- * @fn Array *String::componentsSeparatedByCharacters(const String *self, const char *chars)
- * @memberof String
+ * @return An Array of the components of `self` that were separated by `chars`, as Slices if
+ * `slices` is true, and as Strings otherwise.
  */
-static Array *componentsSeparatedByCharacters(const String *self, const char *chars) {
+static Array *separate(const String *self, const char *chars, bool slices) {
 
   assert(chars);
 
@@ -191,9 +588,9 @@ static Array *componentsSeparatedByCharacters(const String *self, const char *ch
   while (result.length) {
     search.length = result.location - search.location;
 
-    String *component = $(self, substring, search);
-    $(components, addObject, component);
-    release(component);
+    ident obj = slices ? (ident) $(self, slice, search) : (ident) $(self, substring, search);
+    $(components, addObject, obj);
+    release(obj);
 
     search.location = result.location + result.length;
     search.length = self->length - search.location;
@@ -201,13 +598,21 @@ static Array *componentsSeparatedByCharacters(const String *self, const char *ch
     result = $(self, rangeOfCharacters, chars, search);
   }
 
-  String *component = $(self, substring, search);
-  $(components, addObject, component);
-  release(component);
+  ident obj = slices ? (ident) $(self, slice, search) : (ident) $(self, substring, search);
+  $(components, addObject, obj);
+  release(obj);
 
   return components;
 }
 
+/**
+ * @fn Array *String::componentsSeparatedByCharacters(const String *self, const char *chars)
+ * @memberof String
+ */
+static Array *componentsSeparatedByCharacters(const String *self, const char *chars) {
+  return separate(self, chars, false);
+}
+
 /**
  * @fn Array *String::componentsSeparatedByString(const String *self, const String *string)
  * @memberof String
@@ -230,11 +635,13 @@ static Data *getData(const String *self, StringEncoding encoding) {
     .from = STRING_ENCODING_UTF8,
     .in = self->chars,
     .length = self->length,
-    .out = calloc(self->length, sizeof(Unicode) / sizeof(char)),
-    .size = self->length * sizeof(Unicode)
   };
 
-  assert(trans.out);
+  trans.size = transcodedSize(&trans);
+  if (trans.size) {
+    trans.out = malloc(trans.size);
+    assert(trans.out);
+  }
 
   const size_t size = transcode(&trans);
   assert(size <= trans.size);
@@ -270,30 +677,386 @@ static bool hasSuffix(const String *self, const String *suffix) {
   return $(self, compareTo, suffix, range) == OrderSame;
 }
 
+/**
+ * @brief An open-addressed table of interned Strings, which `internedStringWithCharacters` probes
+ * without locking. Written only under `_internLock`, and never resized in place: a full table is
+ * copied and the copy published, so that a reader never sees a slot move. The table it replaced
+ * is retired rather than freed, because a reader may still be probing it.
+ */
+typedef struct InternTable InternTable;
+struct InternTable {
+  size_t capacity;
+  size_t count;
+  InternTable *retired;
+  String *slots[];
+};
+
+#define INTERN_TABLE_DEFAULT_CAPACITY 1024
+
+/**
+ * @brief The table of interned Strings.
+ */
+static InternTable *_internTable;
+
+/**
+ * @brief Guards the structure of `_internTable`.
+ */
+static pthread_mutex_t _internLock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * @return The interned String for `chars` in the given InternTable, or `NULL`.
+ * @remarks Safe to call without holding `_internLock`.
+ */
+static String *lookupInterned(const InternTable *table, const char *chars, size_t length, int hash) {
+
+  if (table == NULL) {
+    return NULL;
+  }
+
+  const size_t mask = table->capacity - 1;
+
+  for (size_t i = (uint32_t) hash & mask;; i = (i + 1) & mask) {
+
+    String *slot = __atomic_load_n(&table->slots[i], __ATOMIC_ACQUIRE);
+    if (slot == NULL) {
+      return NULL;
+    }
+
+    if (slot->hash == hash && slot->length == length && memcmp(slot->chars, chars, length) == 0) {
+      return slot;
+    }
+  }
+}
+
+/**
+ * @brief Adds the interned `string` to the InternTable at `table`.
+ * @remarks The caller MUST hold `_internLock`.
+ */
+static void insertInterned(InternTable **table, String *string) {
+
+  InternTable *in = *table;
+
+  if (in == NULL || (in->count + 1) * 4 > in->capacity * 3) {
+
+    const size_t capacity = in ? in->capacity << 1 : INTERN_TABLE_DEFAULT_CAPACITY;
+
+    InternTable *out = calloc(1, sizeof(InternTable) + capacity * sizeof(String *));
+    assert(out);
+
+    out->capacity = capacity;
+    out->retired = in;
+
+    if (in) {
+      for (size_t i = 0; i < in->capacity; i++) {
+        if (in->slots[i]) {
+          insertInterned(&out, in->slots[i]);
+        }
+      }
+    }
+
+    __atomic_store_n(table, out, __ATOMIC_RELEASE);
+    in = out;
+  }
+
+  const size_t mask = in->capacity - 1;
+
+  for (size_t i = (uint32_t) string->hash & mask;; i = (i + 1) & mask) {
+    if (in->slots[i] == NULL) {
+      __atomic_store_n(&in->slots[i], string, __ATOMIC_RELEASE);
+      in->count++;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Interns the given characters.
+ * @param literal The statically allocated String of a `strlit` to intern, if no equal String is
+ * interned already, or `NULL` to allocate one.
+ * @return The interned String.
+ */
+static String *intern(const char *chars, size_t length, String *literal) {
+
+  const int hash = (int) Hash64ForBytes(Hash64Seed(), chars, length);
+
+  String *string = lookupInterned(__atomic_load_n(&_internTable, __ATOMIC_ACQUIRE), chars, length, hash);
+  if (string == NULL) {
+
+    pthread_mutex_lock(&_internLock);
+
+    string = lookupInterned(_internTable, chars, length, hash);
+    if (string == NULL) {
+
+      if (literal) {
+        string = _instantiate(_String(), literal);
+        string->capacity = length + 1;
+        string->object.flags |= OBJECT_STATIC;
+      } else {
+        string = $(alloc(String), initWithCapacity, length + 1);
+        assert(string);
+
+        memcpy(string->chars, chars, length);
+        string->chars[length] = '\0';
+        string->length = length;
+      }
+
+      string->hash = hash;
+      string->interned = true;
+
+      insertInterned(&_internTable, immortalize(string));
+    }
+
+    pthread_mutex_unlock(&_internLock);
+  }
+
+  return string;
+}
+
+/**
+ * @fn String *String::internedStringWithCharacters(const char *chars, size_t length)
+ * @memberof String
+ */
+static String *internedStringWithCharacters(const char *chars, size_t length) {
+  return intern(chars, length, NULL);
+}
+
+/**
+ * @fn String *String::internedString(const String *self)
+ * @memberof String
+ */
+static String *internedString(const String *self) {
+
+  if (self->interned) {
+    return (String *) self;
+  }
+
+  return internedStringWithCharacters(self->chars, self->length);
+}
+
 /**
  * @fn String *String::initWithBytes(String *self, const uint8_t *bytes, size_t length, StringEncoding encoding)
  * @memberof String
  */
+/**
+ * @brief Maps the case of the ASCII run at the head of `in`.
+ * @param in The input.
+ * @param length The length of `in`, in bytes.
+ * @param out The output, with room for `length` bytes.
+ * @param upper True to map to uppercase, false to map to lowercase.
+ * @return The number of bytes mapped, which stops short of the first non-ASCII byte.
+ */
+static size_t mapCaseASCII(const uint8_t *in, size_t length, uint8_t *out, bool upper) {
+
+  const uint8_t first = upper ? 'a' : 'A';
+  const uint8_t last = upper ? 'z' : 'Z';
+
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i below = _mm_set1_epi8(first - 1);
+  const __m128i above = _mm_set1_epi8(last + 1);
+  const __m128i flip = _mm_set1_epi8(0x20);
+
+  for (; i + 16 <= length; i += 16) {
+    const __m128i v = _mm_loadu_si128((const __m128i *) (in + i));
+    if (_mm_movemask_epi8(v)) {
+      break;
+    }
+
+    const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(v, below), _mm_cmplt_epi8(v, above));
+    _mm_storeu_si128((__m128i *) (out + i), _mm_xor_si128(v, _mm_and_si128(letters, flip)));
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t lo = vdupq_n_u8(first);
+  const uint8x16_t hi = vdupq_n_u8(last);
+  const uint8x16_t flip = vdupq_n_u8(0x20);
+
+  for (; i + 16 <= length; i += 16) {
+    const uint8x16_t v = vld1q_u8(in + i);
+    if (vmaxvq_u8(v) & 0x80) {
+      break;
+    }
+
+    const uint8x16_t letters = vandq_u8(vcgeq_u8(v, lo), vcleq_u8(v, hi));
+    vst1q_u8(out + i, veorq_u8(v, vandq_u8(letters, flip)));
+  }
+#endif
+
+  for (; i < length && in[i] < 0x80; i++) {
+    const uint8_t c = in[i];
+    out[i] = (c >= first && c <= last) ? c ^ 0x20 : c;
+  }
+
+  return i;
+}
+
+/**
+ * @brief Maps the case of a single code point.
+ * @details Latin-1 is mapped by its Unicode simple case mappings. Other code points are mapped by
+ * `towlower` and `towupper`, and so by the current locale.
+ */
+static uint32_t mapCaseCodepoint(uint32_t codepoint, bool upper) {
+
+  if (codepoint < 0x100) {
+    if (upper) {
+      if (codepoint >= 0xe0 && codepoint <= 0xfe && codepoint != 0xf7) {
+        return codepoint - 0x20;
+      } else if (codepoint == 0xff) {
+        return 0x178;
+      } else if (codepoint == 0xb5) {
+        return 0x39c;
+      }
+    } else {
+      if (codepoint >= 0xc0 && codepoint <= 0xde && codepoint != 0xd7) {
+        return codepoint + 0x20;
+      }
+    }
+    return codepoint;
+  }
+
+  if (codepoint > WCHAR_MAX) {
+    return codepoint;
+  }
+
+  const uint32_t mapped = upper ? towupper(codepoint) : towlower(codepoint);
+  if (mapped > 0x10ffff || (mapped >= 0xd800 && mapped <= 0xdfff)) {
+    return codepoint;
+  }
+
+  return mapped;
+}
+
+/**
+ * @brief Maps the case of `self` directly in UTF-8, without transcoding it.
+ * @details Runs of ASCII are mapped in bulk. Malformed UTF-8 is copied through unchanged.
+ */
+static String *mapCase(const String *self, bool upper) {
+
+  const uint8_t *in = (const uint8_t *) self->chars;
+  const uint8_t *end = in + self->length;
+
+  size_t capacity = self->length + 5;
+  uint8_t *out = malloc(capacity);
+  assert(out);
+
+  size_t size = 0;
+
+  while (in < end) {
+
+    const size_t remaining = end - in;
+    if (size + remaining + 5 > capacity) {
+      capacity = (capacity << 1) + remaining;
+      out = realloc(out, capacity);
+      assert(out);
+    }
+
+    if (*in < 0x80) {
+      const size_t len = mapCaseASCII(in, remaining, out + size, upper);
+      in += len;
+      size += len;
+    } else {
+      uint32_t codepoint;
+      const size_t len = decodeUTF8(in, remaining, &codepoint);
+      if (len) {
+        size += encodeUTF8(mapCaseCodepoint(codepoint, upper), out + size);
+        in += len;
+      } else {
+        out[size++] = *in++;
+      }
+    }
+  }
+
+  out[size] = '\0';
+
+  return $$(String, stringWithMemory, out, size);
+}
+
 /**
  * @fn String *String::lowercaseString(const String *self)
  * @memberof String
  */
 static String *lowercaseString(const String *self) {
+  return mapCase(self, false);
+}
 
-  Data *data = $(self, getData, STRING_ENCODING_WCHAR);
-  assert(data);
+/**
+ * @brief Finds the first occurrence of `needle` in `haystack`.
+ * @details Candidates are found sixteen at a time, by comparing the first and last bytes of
+ * `needle` against sixteen consecutive offsets of `haystack` with SSE2 or NEON, and only then
+ * compared in full. Without either, candidates are found with `memchr`.
+ * @param haystack The bytes to search.
+ * @param length The length of `haystack`.
+ * @param needle The bytes to search for.
+ * @param len The length of `needle`.
+ * @return The first occurrence of `needle` lying wholly within `haystack`, or `NULL`.
+ */
+static const char *search(const char *haystack, size_t length, const char *needle, size_t len) {
+
+  if (len == 0) {
+    return haystack;
+  } else if (len > length) {
+    return NULL;
+  } else if (len == 1) {
+    return memchr(haystack, needle[0], length);
+  }
+
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[len - 1]);
 
-  const size_t codepoints = data->length / sizeof(Unicode);
-  Unicode *unicode = (Unicode *) data->bytes;
+  for (; i + len - 1 + 16 <= length; i += 16) {
 
-  for (size_t i = 0; i < codepoints; i++, unicode++) {
-    *unicode = towlower(*unicode);
+    const __m128i a = _mm_loadu_si128((const __m128i *) (haystack + i));
+    const __m128i b = _mm_loadu_si128((const __m128i *) (haystack + i + len - 1));
+
+    unsigned int mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last)));
+    while (mask) {
+      const size_t offset = i + __builtin_ctz(mask);
+      if (memcmp(haystack + offset + 1, needle + 1, len - 2) == 0) {
+        return haystack + offset;
+      }
+      mask &= mask - 1;
+    }
   }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const uint8x16_t first = vdupq_n_u8(needle[0]);
+  const uint8x16_t last = vdupq_n_u8(needle[len - 1]);
 
-  String *lowercase = $$(String, stringWithData, data, STRING_ENCODING_WCHAR);
+  for (; i + len - 1 + 16 <= length; i += 16) {
 
-  release(data);
-  return lowercase;
+    const uint8x16_t a = vld1q_u8((const uint8_t *) haystack + i);
+    const uint8x16_t b = vld1q_u8((const uint8_t *) haystack + i + len - 1);
+
+    const uint8x16_t eq = vandq_u8(vceqq_u8(a, first), vceqq_u8(b, last));
+
+    uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+    while (mask) {
+      const size_t offset = i + (__builtin_ctzll(mask) >> 2);
+      if (memcmp(haystack + offset + 1, needle + 1, len - 2) == 0) {
+        return haystack + offset;
+      }
+      mask &= ~(0xfull << (__builtin_ctzll(mask) & ~3));
+    }
+  }
+#endif
+
+  while (i + len <= length) {
+
+    const char *candidate = memchr(haystack + i, needle[0], length - len + 1 - i);
+    if (candidate == NULL) {
+      break;
+    }
+
+    if (memcmp(candidate + 1, needle + 1, len - 1) == 0) {
+      return candidate;
+    }
+
+    i = candidate - haystack + 1;
+  }
+
+  return NULL;
 }
 
 /**
@@ -310,13 +1073,10 @@ static Range rangeOfCharacters(const String *self, const char *chars, const Rang
   Range match = { -1, 0 };
   const size_t len = strlen(chars);
 
-  const char *str = self->chars + range.location;
-  for (size_t i = 0; i < range.length; i++, str++) {
-    if (strncmp(str, chars, len) == 0) {
-      match.location = range.location + i;
-      match.length = len;
-      break;
-    }
+  const char *str = search(self->chars + range.location, range.length, chars, len);
+  if (str) {
+    match.location = str - self->chars;
+    match.length = len;
   }
 
   return match;
@@ -394,6 +1154,22 @@ static String *stringWithMemory(const ident mem, size_t length) {
   return $(alloc(String), initWithMemory, mem, length);
 }
 
+/**
+ * @fn Slice *String::slice(const String *self, const Range range)
+ * @memberof String
+ */
+static Slice *slice(const String *self, const Range range) {
+  return $(alloc(Slice), initWithString, self, range);
+}
+
+/**
+ * @fn Array *String::slicesSeparatedByCharacters(const String *self, const char *chars)
+ * @memberof String
+ */
+static Array *slicesSeparatedByCharacters(const String *self, const char *chars) {
+  return separate(self, chars, true);
+}
+
 /**
  * @fn String *String::substring(const String *string, const Range range)
  * @memberof String
@@ -402,19 +1178,20 @@ static String *substring(const String *self, const Range range) {
 
   assert(range.location + range.length <= self->length);
 
-  ident mem = calloc(range.length + 1, sizeof(char));
-  assert(mem);
+  String *string = $(alloc(String), initWithCapacity, range.length + 1);
+  assert(string);
 
-  strncpy(mem, self->chars + range.location, range.length);
+  memcpy(string->chars, self->chars + range.location, range.length);
+  string->chars[range.length] = '\0';
+  string->length = range.length;
 
-  return $(alloc(String), initWithMemory, mem, range.length);
+  return string;
 }
 
 /**
- * @fn String *String::trimmedString(const String *self)
- * @memberof String
+ * @return The Range of `self` excluding leading and trailing whitespace.
  */
-static String *trimmedString(const String *self) {
+static Range trimmedRange(const String *self) {
 
   Range range = { .location = 0, .length = self->length };
 
@@ -427,29 +1204,31 @@ static String *trimmedString(const String *self) {
     range.length--;
   }
 
-  return $(self, substring, range);
+  return range;
 }
 
 /**
- * @fn String *String::uppercaseString(const String *self)
+ * @fn Slice *String::trimmedSlice(const String *self)
  * @memberof String
  */
-static String *uppercaseString(const String *self) {
-
-  Data *data = $(self, getData, STRING_ENCODING_WCHAR);
-  assert(data);
-
-  const size_t codepoints = data->length / sizeof(Unicode);
-  Unicode *unicode = (Unicode *) data->bytes;
-
-  for (size_t i = 0; i < codepoints; i++, unicode++) {
-    *unicode = towupper(*unicode);
-  }
+static Slice *trimmedSlice(const String *self) {
+  return $(self, slice, trimmedRange(self));
+}
 
-  String *uppercase = $$(String, stringWithData, data, STRING_ENCODING_WCHAR);
+/**
+ * @fn String *String::trimmedString(const String *self)
+ * @memberof String
+ */
+static String *trimmedString(const String *self) {
+  return $(self, substring, trimmedRange(self));
+}
 
-  release(data);
-  return uppercase;
+/**
+ * @fn String *String::uppercaseString(const String *self)
+ * @memberof String
+ */
+static String *uppercaseString(const String *self) {
+  return mapCase(self, true);
 }
 
 /**
@@ -469,12 +1248,41 @@ static bool writeToFile(const String *self, const char *path, StringEncoding enc
 
 #pragma mark - String mutation
 
+/**
+ * @brief Ensures that `self` can hold `size` bytes, including the null terminator.
+ * @details Capacity grows geometrically, so that repeated appends are amortized.
+ */
+static void reserve(String *self, size_t size) {
+
+  if (size > self->capacity) {
+
+    size_t capacity = self->capacity << 1;
+    if (capacity < size) {
+      capacity = size;
+    }
+
+    if (self->chars == self->storage) {
+      self->chars = malloc(capacity);
+      assert(self->chars);
+
+      memcpy(self->chars, self->storage, self->length + 1);
+    } else {
+      self->chars = realloc(self->chars, capacity);
+      assert(self->chars);
+    }
+
+    self->capacity = capacity;
+  }
+}
+
 /**
  * @fn void String::appendBytes(String *self, const uint8_t *bytes, size_t length, StringEncoding encoding)
  * @memberof String
  */
 static void appendBytes(String *self, const uint8_t *bytes, size_t length, StringEncoding encoding) {
 
+  assert(self->interned == false);
+
   if (bytes) {
 
     Transcode trans = {
@@ -482,20 +1290,22 @@ static void appendBytes(String *self, const uint8_t *bytes, size_t length, Strin
       .from = encoding,
       .in = (char *) bytes,
       .length = length,
-      .out = calloc(length * sizeof(Unicode) + 1, sizeof(char)),
-      .size = length * sizeof(Unicode) + 1
     };
 
-    assert(trans.out);
+    trans.size = transcodedSize(&trans);
+    if (trans.size) {
 
-    const size_t size = transcode(&trans);
-    assert(size < trans.size);
+      reserve(self, self->length + trans.size + 1);
 
-    trans.out[size] = '\0';
+      trans.out = self->chars + self->length;
 
-    $(self, appendCharacters, trans.out);
+      const size_t size = transcode(&trans);
+      assert(size <= trans.size);
 
-    free(trans.out);
+      self->length += strnlen(trans.out, size);
+      self->chars[self->length] = '\0';
+      self->hash = 0;
+    }
   }
 }
 
@@ -505,31 +1315,23 @@ static void appendBytes(String *self, const uint8_t *bytes, size_t length, Strin
  */
 static void appendCharacters(String *self, const char *chars) {
 
+  assert(self->interned == false);
+
   if (chars) {
 
     const size_t len = strlen(chars);
     if (len) {
 
-      const size_t newSize = self->length + strlen(chars) + 1;
-      const size_t newCapacity = (newSize / _pageSize + 1) * _pageSize;
-
-      if (newCapacity > self->capacity) {
-
-        if (self->length) {
-          self->chars = realloc(self->chars, newCapacity);
-        } else {
-          self->chars = malloc(newCapacity);
-        }
+      const size_t newSize = self->length + len + 1;
 
-        assert(self->chars);
-        self->capacity = newCapacity;
-      }
+      reserve(self, newSize);
 
       ident ptr = self->chars + self->length;
       memmove(ptr, chars, len);
 
       self->chars[newSize - 1] = '\0';
       self->length += len;
+      self->hash = 0;
     }
   }
 }
@@ -580,6 +1382,7 @@ static void appendVaList(String *self, const char *fmt, va_list args) {
  */
 static void deleteCharactersInRange(String *self, const Range range) {
 
+  assert(self->interned == false);
   assert(range.location >= 0);
   assert(range.length <= self->length);
 
@@ -589,6 +1392,7 @@ static void deleteCharactersInRange(String *self, const Range range) {
   memmove(ptr, ptr + range.length, length);
 
   self->length -= range.length;
+  self->hash = 0;
 }
 
 /**
@@ -621,10 +1425,11 @@ static String *initWithCapacity(String *self, size_t capacity) {
 
   self = $(self, initWithMemory, NULL, 0);
   if (self) {
-    self->capacity = capacity;
-    if (self->capacity) {
-      self->chars = calloc(self->capacity, sizeof(char));
+    if (capacity > self->capacity) {
+      self->chars = calloc(capacity, sizeof(char));
       assert(self->chars);
+
+      self->capacity = capacity;
     }
   }
 
@@ -701,9 +1506,15 @@ static String *initWithMemory(String *self, const ident mem, size_t length) {
 
   self = (String *) super(Object, self, init);
   if (self) {
-    self->chars = (char *) mem;
-    self->length = length;
-    self->capacity = self->chars ? length + 1 : 0;
+    if (mem) {
+      self->chars = (char *) mem;
+      self->length = length;
+      self->capacity = length + 1;
+    } else {
+      self->chars = self->storage;
+      self->length = 0;
+      self->capacity = STRING_INLINE_CAPACITY;
+    }
   }
 
   return self;
@@ -763,16 +1574,18 @@ static void insertStringAtIndex(String *self, const String *string, size_t index
  */
 static void replaceCharactersInRange(String *self, const Range range, const char *chars) {
 
+  assert(self->interned == false);
   assert(range.location >= 0);
   assert(range.location + range.length <= self->length);
 
-  if (self->capacity == 0) {
+  if (self->length == 0) {
     $(self, appendCharacters, chars);
   } else {
     char *remainder = strdup(self->chars + range.location + range.length);
 
     self->length = range.location;
-    self->chars[range.location + 1] = '\0';
+    self->chars[range.location] = '\0';
+    self->hash = 0;
 
     $(self, appendCharacters, chars);
     $(self, appendCharacters, remainder);
@@ -795,28 +1608,77 @@ static void replaceOccurrencesOfCharacters(String *self, const char *chars, cons
  */
 static void replaceOccurrencesOfCharactersInRange(String *self, const char *chars, const Range range, const char *replacement) {
 
+  assert(self->interned == false);
+
   assert(chars);
   assert(replacement);
 
   assert(range.location >= 0);
   assert(range.location + range.length <= self->length);
 
-  Range search = range;
-  while (true) {
+  const size_t len = strlen(chars);
+  if (len == 0) {
+    return;
+  }
 
-    const Range result = $((String *) self, rangeOfCharacters, chars, search);
-    if (result.location == -1) {
-      break;
+  const char *end = self->chars + range.location + range.length;
+
+  const char *match = search(self->chars + range.location, range.length, chars, len);
+  if (match == NULL) {
+    return;
+  }
+
+  const size_t replacementLength = strlen(replacement);
+
+  char *buffer = self->chars;
+  size_t capacity = self->capacity;
+
+  if (replacementLength > len) {
+
+    size_t count = 0;
+    for (const char *m = match; m; m = search(m + len, end - (m + len), chars, len)) {
+      count++;
     }
 
-    $(self, replaceCharactersInRange, result, replacement);
+    capacity = self->length + count * (replacementLength - len) + 1;
+
+    buffer = malloc(capacity);
+    assert(buffer);
+
+    memcpy(buffer, self->chars, match - self->chars);
+  }
+
+  char *out = buffer + (match - self->chars);
+  const char *in = match;
 
-    search.length -= (result.location - search.location);
-    search.length -= strlen(replacement);
-    search.length += ((int) strlen(replacement) - (int) strlen(chars));
+  while (match) {
 
-    search.location = result.location + strlen(replacement);
+    memmove(out, in, match - in);
+    out += match - in;
+
+    memcpy(out, replacement, replacementLength);
+    out += replacementLength;
+
+    in = match + len;
+    match = search(in, end - in, chars, len);
+  }
+
+  const size_t remaining = self->chars + self->length - in;
+  memmove(out, in, remaining);
+  out += remaining;
+
+  *out = '\0';
+
+  if (buffer != self->chars) {
+    if (self->chars != self->storage) {
+      free(self->chars);
+    }
+    self->chars = buffer;
+    self->capacity = capacity;
   }
+
+  self->length = out - buffer;
+  self->hash = 0;
 }
 
 /**
@@ -881,9 +1743,12 @@ static void setFormat(String *self, const char *fmt, ...) {
  */
 static void setLength(String *self, size_t length) {
 
+  assert(self->interned == false);
+
   if (length < self->length) {
     self->length = length;
     self->chars[length] = '\0';
+    self->hash = 0;
   }
 }
 
@@ -898,6 +1763,37 @@ static void setString(String *self, const String *string) {
   $(self, appendString, string);
 }
 
+/**
+ * @fn void String::shrinkToFit(String *self)
+ * @memberof String
+ */
+static void shrinkToFit(String *self) {
+
+  /* An interned String may be read by any thread, and may point at a literal. */
+  if (self->interned) {
+    return;
+  }
+
+  if (self->chars != self->storage) {
+
+    const size_t size = self->length + 1;
+    if (size <= STRING_INLINE_CAPACITY) {
+
+      memcpy(self->storage, self->chars, size);
+      free(self->chars);
+
+      self->chars = self->storage;
+      self->capacity = STRING_INLINE_CAPACITY;
+    } else if (size < self->capacity) {
+
+      self->chars = realloc(self->chars, size);
+      assert(self->chars);
+
+      self->capacity = size;
+    }
+  }
+}
+
 /**
  * @fn String *String::string(void)
  * @memberof String
@@ -929,6 +1825,29 @@ static void trim(String *self) {
 
 #pragma mark - Class lifecycle
 
+/**
+ * @see Class::destroy(Class *)
+ */
+static void destroy(Class *clazz) {
+
+  InternTable *table = _internTable;
+  if (table) {
+    for (size_t i = 0; i < table->capacity; i++) {
+      if (table->slots[i] && (table->slots[i]->object.flags & OBJECT_STATIC) == 0) {
+        $((Object *) table->slots[i], dealloc);
+      }
+    }
+  }
+
+  while (table) {
+    InternTable *retired = table->retired;
+    free(table);
+    table = retired;
+  }
+
+  _internTable = NULL;
+}
+
 /**
  * @see Class::initialize(Class *)
  */
@@ -965,6 +1884,8 @@ static void initialize(Class *clazz) {
   ((StringInterface *) clazz->interface)->initWithString = initWithString;
   ((StringInterface *) clazz->interface)->insertCharactersAtIndex = insertCharactersAtIndex;
   ((StringInterface *) clazz->interface)->insertStringAtIndex = insertStringAtIndex;
+  ((StringInterface *) clazz->interface)->internedString = internedString;
+  ((StringInterface *) clazz->interface)->internedStringWithCharacters = internedStringWithCharacters;
   ((StringInterface *) clazz->interface)->replaceCharactersInRange = replaceCharactersInRange;
   ((StringInterface *) clazz->interface)->replaceOccurrencesOfCharacters = replaceOccurrencesOfCharacters;
   ((StringInterface *) clazz->interface)->replaceOccurrencesOfCharactersInRange = replaceOccurrencesOfCharactersInRange;
@@ -975,6 +1896,9 @@ static void initialize(Class *clazz) {
   ((StringInterface *) clazz->interface)->setFormat = setFormat;
   ((StringInterface *) clazz->interface)->setLength = setLength;
   ((StringInterface *) clazz->interface)->setString = setString;
+  ((StringInterface *) clazz->interface)->shrinkToFit = shrinkToFit;
+  ((StringInterface *) clazz->interface)->slice = slice;
+  ((StringInterface *) clazz->interface)->slicesSeparatedByCharacters = slicesSeparatedByCharacters;
   ((StringInterface *) clazz->interface)->string = string;
   ((StringInterface *) clazz->interface)->stringWithCapacity = stringWithCapacity;
   ((StringInterface *) clazz->interface)->trim = trim;
@@ -987,6 +1911,7 @@ static void initialize(Class *clazz) {
   ((StringInterface *) clazz->interface)->stringWithFormat = stringWithFormat;
   ((StringInterface *) clazz->interface)->stringWithMemory = stringWithMemory;
   ((StringInterface *) clazz->interface)->substring = substring;
+  ((StringInterface *) clazz->interface)->trimmedSlice = trimmedSlice;
   ((StringInterface *) clazz->interface)->trimmedString = trimmedString;
   ((StringInterface *) clazz->interface)->uppercaseString = uppercaseString;
   ((StringInterface *) clazz->interface)->writeToFile = writeToFile;
@@ -1008,6 +1933,7 @@ Class *_String(void) {
       .interfaceOffset = offsetof(String, interface),
       .interfaceSize = sizeof(StringInterface),
       .initialize = initialize,
+      .destroy = destroy,
     });
   });
 
@@ -1094,6 +2020,13 @@ String *str(const char *fmt, ...) {
   return string;
 }
 
+String *_strlit(String *literal) {
+
+  assert(literal);
+
+  return intern(literal->chars, literal->length, literal);
+}
+
 char *strtrim(const char *s) {
 
   assert(s);
@@ -56,6 +56,12 @@ typedef enum {
 
 typedef struct StringInterface StringInterface;
 
+/**
+ * @brief The capacity, in bytes and including the null terminator, of the storage within each
+ * String.
+ */
+#define STRING_INLINE_CAPACITY 24
+
 /**
  * @brief UTF-8 strings.
  * @remarks Because Strings are encoded using UTF-8, they must not be treated as ASCII C strings.
@@ -94,6 +100,27 @@ struct String {
    * @private
    */
   size_t capacity;
+
+  /**
+   * @brief The hash of `chars`, or `0` if it is yet to be computed.
+   * @details Computed on demand by `Object::hash`, and cleared by each method that mutates `chars`.
+   * @private
+   */
+  int hash;
+
+  /**
+   * @brief True if this String is the canonical instance of its characters.
+   * @see String::internedString(const String *)
+   * @private
+   */
+  bool interned;
+
+  /**
+   * @brief The storage that `chars` refers to, until this String outgrows it.
+   * @details Short Strings, such as most Dictionary keys, thus cost no allocation of their own.
+   * @private
+   */
+  char storage[STRING_INLINE_CAPACITY];
 };
 
 
@@ -352,10 +379,38 @@ struct StringInterface {
    */
   void (*insertStringAtIndex)(String *self, const String *string, size_t index);
 
+  /**
+   * @fn String *String::internedString(const String *self)
+   * @param self The String.
+   * @return The interned String equal to this String.
+   * @see String::internedStringWithCharacters(const char *, size_t)
+   * @memberof String
+   */
+  String *(*internedString)(const String *self);
+
+  /**
+   * @static
+   * @fn String *String::internedStringWithCharacters(const char *chars, size_t length)
+   * @brief Returns the canonical String for the given characters, creating it if necessary.
+   * @param chars The UTF-8 encoded characters, which need not be null-terminated.
+   * @param length The length of `chars`, in bytes.
+   * @return The interned String.
+   * @remarks Equal interned Strings are identical, so they compare by pointer: `Object::isEqual`
+   * answers two distinct interned Strings without comparing their characters, and Dictionary
+   * finds an interned key without calling it at all.
+   * @remarks Interned Strings are immortal, and are shared by every thread, so they MUST NOT be
+   * mutated. Releasing one is harmless, so it may be treated as any other String the caller owns.
+   * @remarks Safe to call from any thread. Lookups do not lock.
+   * @memberof String
+   */
+  String *(*internedStringWithCharacters)(const char *chars, size_t length);
+
   /**
    * @fn String *String::lowercaseString(const String *self)
    * @param self The String.
    * @return A lowercase representation of this String.
+   * @remarks ASCII and Latin-1 are mapped regardless of locale. Other characters are mapped by
+   * `towlower`, and so by the current locale.
    * @memberof String
    */
   String *(*lowercaseString)(const String *self);
@@ -366,7 +421,8 @@ struct StringInterface {
    * @param self The String.
    * @param chars The characters to search for.
    * @param range The Range in which to search.
-   * @return A Range specifying the first occurrence of `chars` in this String.
+   * @return A Range specifying the first occurrence of `chars` lying wholly within `range`, or
+   * `{ -1, 0 }` if there is none.
    * @memberof String
    */
   Range (*rangeOfCharacters)(const String *self, const char *chars, const Range range);
@@ -405,6 +461,8 @@ struct StringInterface {
   /**
    * @fn void String::replaceOccurrencesOfCharactersInRange(String *self, const char *chars, const Range range, const char *replacement)
    * @brief Replaces occurrences of `chars` in `range` with the given `replacement`.
+   * @details Occurrences are replaced from left to right without overlapping, and the String is
+   * rewritten once, regardless of how many there are.
    * @param self The String.
    * @param chars The null-terminated UTF-8 encoded C string to replace.
    * @param range The Range in which to replace.
@@ -480,6 +538,38 @@ struct StringInterface {
    */
   void (*setString)(String *self, const String *string);
 
+  /**
+   * @fn void String::shrinkToFit(String *self)
+   * @brief Reduces the capacity of this String to its length.
+   * @param self The String.
+   * @remarks Strings grow geometrically as they are appended to. Call this once a String is
+   * complete, to release the excess. Interned Strings are left as they are.
+   * @memberof String
+   */
+  void (*shrinkToFit)(String *self);
+
+  /**
+   * @fn Slice *String::slice(const String *self, const Range range)
+   * @brief Creates a Slice of this String, which shares its storage rather than copying it.
+   * @param self The String.
+   * @param range The character Range.
+   * @return The new Slice.
+   * @see Slice::initWithString(Slice *, const String *, const Range)
+   * @memberof String
+   */
+  Slice *(*slice)(const String *self, const Range range);
+
+  /**
+   * @fn Array *String::slicesSeparatedByCharacters(const String *self, const char *chars)
+   * @brief Returns the components of this String that were separated by `chars`, as Slices.
+   * @param self The String.
+   * @param chars The separating characters.
+   * @return An Array of Slices that were separated by `chars`.
+   * @see String::componentsSeparatedByCharacters(const String *, const char *)
+   * @memberof String
+   */
+  Array *(*slicesSeparatedByCharacters)(const String *self, const char *chars);
+
   /**
    * @static
    * @fn String *String::string(void)
@@ -583,6 +673,15 @@ struct StringInterface {
    */
   void (*trim)(String *self);
 
+  /**
+   * @fn Slice *String::trimmedSlice(const String *self)
+   * @brief Creates a Slice of this String with leading and trailing whitespace excluded.
+   * @param self The String.
+   * @return The trimmed Slice.
+   * @memberof String
+   */
+  Slice *(*trimmedSlice)(const String *self);
+
   /**
    * @fn String *String::trimmedString(const String *self)
    * @brief Creates a copy of this String with leading and trailing whitespace removed.
@@ -596,6 +695,8 @@ struct StringInterface {
    * @fn String *String::uppercaseString(const String *self)
    * @param self The String.
    * @return An uppercase representation of this String.
+   * @remarks ASCII and Latin-1 are mapped regardless of locale. Other characters are mapped by
+   * `towupper`, and so by the current locale.
    * @memberof String
    */
   String *(*uppercaseString)(const String *self);
@@ -653,6 +754,40 @@ OBJECTIVELY_EXPORT Order StringCompare(const ident a, const ident b);
  */
 OBJECTIVELY_EXPORT String *str(const char *fmt, ...);
 
+/**
+ * @brief Binds and interns the statically allocated String of a `strlit`.
+ * @param literal The String, initialized with only its characters and length.
+ * @return The interned String for the characters of `literal`, which is `literal` itself unless
+ * an equal String was interned first.
+ * @relates String
+ */
+OBJECTIVELY_EXPORT String *_strlit(String *literal);
+
+/**
+ * @brief Resolves the interned String for the given string literal.
+ * @details The String, including its length, is statically allocated at the call site. Its
+ * characters are the literal itself, in read-only data. The first evaluation binds it to the
+ * String Class and computes its hash, which is seeded per process and so cannot be computed at
+ * compile time. Every evaluation after that is a single load.
+ * @remarks The String is interned and immortal, so it costs no `retain` or `release`, compares
+ * by pointer to any other interned String, such as a JSON object key, and MUST NOT be mutated.
+ * @remarks Safe to evaluate from any thread.
+ * @relates String
+ */
+#define strlit(literal) ({ \
+  static String _literal = { \
+    .chars = (char *) "" literal, \
+    .length = sizeof(literal) - 1, \
+  }; \
+  static String *_string; \
+  String *_s = __atomic_load_n(&_string, __ATOMIC_ACQUIRE); \
+  if (_s == NULL) { \
+    _s = _strlit(&_literal); \
+    __atomic_store_n(&_string, _s, __ATOMIC_RELEASE); \
+  } \
+  _s; \
+})
+
 /**
  * @brief Copies the given null-terminated C string, trimming leading and trailing whitespace.
  * @param s A null-terminated C string.
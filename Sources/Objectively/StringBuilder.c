@@ -0,0 +1,416 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "Config.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#if !defined(__MINGW32__)
+#include <sys/uio.h>
+#endif
+
+#include "StringBuilder.h"
+
+#define _Class _StringBuilder
+
+/**
+ * @brief The capacity of the first chunk. Each chunk after it doubles, up to the maximum.
+ */
+#define STRING_BUILDER_MIN_CHUNK_SIZE 256
+
+/**
+ * @brief The capacity beyond which chunks stop growing, unless a single append requires more.
+ */
+#define STRING_BUILDER_MAX_CHUNK_SIZE (64 * 1024)
+
+struct StringBuilderChunk {
+  StringBuilderChunk *next;
+  size_t length;
+  size_t capacity;
+  char bytes[];
+};
+
+#pragma mark - Object
+
+/**
+ * @see Object::dealloc(Object *)
+ */
+static void dealloc(Object *self) {
+
+  StringBuilder *this = (StringBuilder *) self;
+
+  StringBuilderChunk *chunk = this->head;
+  while (chunk) {
+    StringBuilderChunk *next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+
+  super(Object, self, dealloc);
+}
+
+/**
+ * @see Object::description(const Object *)
+ */
+static String *description(const Object *self) {
+
+  return $((StringBuilder *) self, string);
+}
+
+#pragma mark - StringBuilder
+
+/**
+ * @return The tail chunk of `self`, with at least `size` bytes available.
+ * @remarks If the tail chunk lacks the room, a new one is added, and the remainder of the tail is
+ * left unused.
+ */
+static StringBuilderChunk *reserve(StringBuilder *self, size_t size) {
+
+  StringBuilderChunk *tail = self->tail;
+  if (tail && tail->capacity - tail->length >= size) {
+    return tail;
+  }
+
+  size_t capacity = STRING_BUILDER_MIN_CHUNK_SIZE;
+  if (tail) {
+    capacity = tail->capacity << 1;
+    if (capacity > STRING_BUILDER_MAX_CHUNK_SIZE) {
+      capacity = STRING_BUILDER_MAX_CHUNK_SIZE;
+    }
+  }
+
+  if (capacity < size) {
+    capacity = size;
+  }
+
+  StringBuilderChunk *chunk = malloc(sizeof(StringBuilderChunk) + capacity);
+  assert(chunk);
+
+  chunk->next = NULL;
+  chunk->length = 0;
+  chunk->capacity = capacity;
+
+  if (tail) {
+    tail->next = chunk;
+  } else {
+    self->head = chunk;
+  }
+
+  self->tail = chunk;
+  return chunk;
+}
+
+/**
+ * @fn void StringBuilder::appendBytes(StringBuilder *self, const uint8_t *bytes, size_t length)
+ * @memberof StringBuilder
+ */
+static void appendBytes(StringBuilder *self, const uint8_t *bytes, size_t length) {
+
+  while (length) {
+
+    StringBuilderChunk *chunk = self->tail;
+    if (chunk == NULL || chunk->length == chunk->capacity) {
+      chunk = reserve(self, 1);
+    }
+
+    size_t len = chunk->capacity - chunk->length;
+    if (len > length) {
+      len = length;
+    }
+
+    memcpy(chunk->bytes + chunk->length, bytes, len);
+    chunk->length += len;
+
+    self->length += len;
+
+    bytes += len;
+    length -= len;
+  }
+}
+
+/**
+ * @fn void StringBuilder::appendCharacters(StringBuilder *self, const char *chars)
+ * @memberof StringBuilder
+ */
+static void appendCharacters(StringBuilder *self, const char *chars) {
+
+  if (chars) {
+    $(self, appendBytes, (const uint8_t *) chars, strlen(chars));
+  }
+}
+
+/**
+ * @fn void StringBuilder::appendDescription(StringBuilder *self, const ident obj)
+ * @memberof StringBuilder
+ */
+static void appendDescription(StringBuilder *self, const ident obj) {
+
+  String *desc = $((Object *) obj, description);
+
+  $(self, appendString, desc);
+
+  release(desc);
+}
+
+/**
+ * @fn void StringBuilder::appendFormat(StringBuilder *self, const char *fmt, ...)
+ * @memberof StringBuilder
+ */
+static void appendFormat(StringBuilder *self, const char *fmt, ...) {
+
+  va_list args;
+  va_start(args, fmt);
+
+  $(self, appendVaList, fmt, args);
+
+  va_end(args);
+}
+
+/**
+ * @fn void StringBuilder::appendString(StringBuilder *self, const String *string)
+ * @memberof StringBuilder
+ */
+static void appendString(StringBuilder *self, const String *string) {
+
+  if (string) {
+    $(self, appendBytes, (const uint8_t *) string->chars, string->length);
+  }
+}
+
+/**
+ * @fn void StringBuilder::appendVaList(StringBuilder *self, const char *fmt, va_list args)
+ * @memberof StringBuilder
+ */
+static void appendVaList(StringBuilder *self, const char *fmt, va_list args) {
+
+  va_list copy;
+  va_copy(copy, args);
+
+  StringBuilderChunk *chunk = self->tail;
+
+  const size_t available = chunk ? chunk->capacity - chunk->length : 0;
+  const int len = vsnprintf(available ? chunk->bytes + chunk->length : NULL, available, fmt, args);
+
+  if (len > 0) {
+
+    if ((size_t) len >= available) {
+      chunk = reserve(self, len + 1);
+      vsnprintf(chunk->bytes + chunk->length, len + 1, fmt, copy);
+    }
+
+    chunk->length += len;
+    self->length += len;
+  }
+
+  va_end(copy);
+}
+
+/**
+ * @brief Copies the accumulated text of `self` to `out`.
+ */
+static void flatten(const StringBuilder *self, char *out) {
+
+  for (const StringBuilderChunk *chunk = self->head; chunk; chunk = chunk->next) {
+    memcpy(out, chunk->bytes, chunk->length);
+    out += chunk->length;
+  }
+}
+
+/**
+ * @fn Data *StringBuilder::data(const StringBuilder *self)
+ * @memberof StringBuilder
+ */
+static Data *data(const StringBuilder *self) {
+
+  ident mem = NULL;
+  if (self->length) {
+    mem = malloc(self->length);
+    assert(mem);
+
+    flatten(self, mem);
+  }
+
+  return $$(Data, dataWithMemory, mem, self->length);
+}
+
+/**
+ * @fn StringBuilder *StringBuilder::init(StringBuilder *self)
+ * @memberof StringBuilder
+ */
+static StringBuilder *init(StringBuilder *self) {
+  return (StringBuilder *) super(Object, self, init);
+}
+
+/**
+ * @fn String *StringBuilder::string(const StringBuilder *self)
+ * @memberof StringBuilder
+ */
+static String *string(const StringBuilder *self) {
+
+  String *string = $(alloc(String), initWithCapacity, self->length + 1);
+  assert(string);
+
+  flatten(self, string->chars);
+
+  string->chars[self->length] = '\0';
+  string->length = self->length;
+
+  return string;
+}
+
+#if defined(__MINGW32__)
+
+/**
+ * @fn bool StringBuilder::writeToFileDescriptor(const StringBuilder *self, int fd)
+ * @memberof StringBuilder
+ */
+static bool writeToFileDescriptor(const StringBuilder *self, int fd) {
+
+  for (const StringBuilderChunk *chunk = self->head; chunk; chunk = chunk->next) {
+
+    const char *bytes = chunk->bytes;
+    size_t length = chunk->length;
+
+    while (length) {
+      const ssize_t n = write(fd, bytes, length);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+
+      bytes += n;
+      length -= n;
+    }
+  }
+
+  return true;
+}
+
+#else
+
+#if !defined(IOV_MAX)
+#define IOV_MAX 1024
+#endif
+
+/**
+ * @fn bool StringBuilder::writeToFileDescriptor(const StringBuilder *self, int fd)
+ * @memberof StringBuilder
+ */
+static bool writeToFileDescriptor(const StringBuilder *self, int fd) {
+
+  struct iovec iov[IOV_MAX < 64 ? IOV_MAX : 64];
+
+  const StringBuilderChunk *chunk = self->head;
+  while (chunk) {
+
+    int count = 0;
+    while (chunk && count < (int) lengthof(iov)) {
+      if (chunk->length) {
+        iov[count++] = (struct iovec) { .iov_base = (char *) chunk->bytes, .iov_len = chunk->length };
+      }
+      chunk = chunk->next;
+    }
+
+    struct iovec *v = iov;
+    while (count) {
+
+      ssize_t n = writev(fd, v, count);
+      if (n < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        return false;
+      }
+
+      while (count && (size_t) n >= v->iov_len) {
+        n -= v->iov_len;
+        v++;
+        count--;
+      }
+
+      if (count) {
+        v->iov_base = (char *) v->iov_base + n;
+        v->iov_len -= n;
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif
+
+#pragma mark - Class lifecycle
+
+/**
+ * @see Class::initialize(Class *)
+ */
+static void initialize(Class *clazz) {
+
+  ((ObjectInterface *) clazz->interface)->dealloc = dealloc;
+  ((ObjectInterface *) clazz->interface)->description = description;
+
+  ((StringBuilderInterface *) clazz->interface)->appendBytes = appendBytes;
+  ((StringBuilderInterface *) clazz->interface)->appendCharacters = appendCharacters;
+  ((StringBuilderInterface *) clazz->interface)->appendDescription = appendDescription;
+  ((StringBuilderInterface *) clazz->interface)->appendFormat = appendFormat;
+  ((StringBuilderInterface *) clazz->interface)->appendString = appendString;
+  ((StringBuilderInterface *) clazz->interface)->appendVaList = appendVaList;
+  ((StringBuilderInterface *) clazz->interface)->data = data;
+  ((StringBuilderInterface *) clazz->interface)->init = init;
+  ((StringBuilderInterface *) clazz->interface)->string = string;
+  ((StringBuilderInterface *) clazz->interface)->writeToFileDescriptor = writeToFileDescriptor;
+}
+
+/**
+ * @fn Class *StringBuilder::_StringBuilder(void)
+ * @memberof StringBuilder
+ */
+Class *_StringBuilder(void) {
+  static Class *clazz;
+  static Once once;
+
+  do_once(&once, {
+    clazz = _initialize(&(const ClassDef) {
+      .name = "StringBuilder",
+      .superclass = _Object(),
+      .instanceSize = sizeof(StringBuilder),
+      .interfaceOffset = offsetof(StringBuilder, interface),
+      .interfaceSize = sizeof(StringBuilderInterface),
+      .initialize = initialize,
+    });
+  });
+
+  return clazz;
+}
+
+#undef _Class
@@ -0,0 +1,193 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#pragma once
+
+#include <Objectively/String.h>
+
+/**
+ * @file
+ * @brief StringBuilders accumulate large text incrementally, without reallocating it.
+ */
+
+typedef struct StringBuilder StringBuilder;
+typedef struct StringBuilderInterface StringBuilderInterface;
+
+/**
+ * @brief A chunk of a StringBuilder.
+ * @private
+ */
+typedef struct StringBuilderChunk StringBuilderChunk;
+
+/**
+ * @brief StringBuilders accumulate large text incrementally, without reallocating it.
+ * @details Appending to a String reallocates, and so copies, everything appended before it each
+ * time its capacity is exceeded. A StringBuilder appends into a list of chunks instead, each
+ * larger than the last, so that every byte is copied in exactly once. The result is then either
+ * flattened once, to a String or Data, or written directly to a file descriptor.
+ * @extends Object
+ * @ingroup ByteStreams
+ */
+struct StringBuilder {
+
+  /**
+   * @brief The superclass.
+   */
+  Object object;
+
+  /**
+   * @brief The interface.
+   * @protected
+   */
+  StringBuilderInterface *interface;
+
+  /**
+   * @brief The length of the accumulated text, in bytes.
+   */
+  size_t length;
+
+  /**
+   * @brief The first chunk.
+   * @private
+   */
+  StringBuilderChunk *head;
+
+  /**
+   * @brief The last chunk, to which bytes are appended.
+   * @private
+   */
+  StringBuilderChunk *tail;
+};
+
+/**
+ * @brief The StringBuilder interface.
+ */
+struct StringBuilderInterface {
+
+  /**
+   * @brief The superclass interface.
+   */
+  ObjectInterface objectInterface;
+
+  /**
+   * @fn void StringBuilder::appendBytes(StringBuilder *self, const uint8_t *bytes, size_t length)
+   * @brief Appends the given UTF-8 encoded `bytes`.
+   * @param self The StringBuilder.
+   * @param bytes The bytes.
+   * @param length The length of `bytes`.
+   * @memberof StringBuilder
+   */
+  void (*appendBytes)(StringBuilder *self, const uint8_t *bytes, size_t length);
+
+  /**
+   * @fn void StringBuilder::appendCharacters(StringBuilder *self, const char *chars)
+   * @brief Appends the given UTF-8 encoded C string.
+   * @param self The StringBuilder.
+   * @param chars The null-terminated C string.
+   * @memberof StringBuilder
+   */
+  void (*appendCharacters)(StringBuilder *self, const char *chars);
+
+  /**
+   * @fn void StringBuilder::appendDescription(StringBuilder *self, const ident obj)
+   * @brief Appends the description of the given Object.
+   * @param self The StringBuilder.
+   * @param obj The Object.
+   * @memberof StringBuilder
+   */
+  void (*appendDescription)(StringBuilder *self, const ident obj);
+
+  /**
+   * @fn void StringBuilder::appendFormat(StringBuilder *self, const char *fmt, ...)
+   * @brief Appends the given format string.
+   * @param self The StringBuilder.
+   * @param fmt The format string.
+   * @remarks The formatted text is written directly into a chunk.
+   * @memberof StringBuilder
+   */
+  void (*appendFormat)(StringBuilder *self, const char *fmt, ...);
+
+  /**
+   * @fn void StringBuilder::appendString(StringBuilder *self, const String *string)
+   * @brief Appends the given String.
+   * @param self The StringBuilder.
+   * @param string The String.
+   * @memberof StringBuilder
+   */
+  void (*appendString)(StringBuilder *self, const String *string);
+
+  /**
+   * @fn void StringBuilder::appendVaList(StringBuilder *self, const char *fmt, va_list args)
+   * @brief Appends the given format string.
+   * @param self The StringBuilder.
+   * @param fmt The format string.
+   * @param args The format arguments.
+   * @memberof StringBuilder
+   */
+  void (*appendVaList)(StringBuilder *self, const char *fmt, va_list args);
+
+  /**
+   * @fn Data *StringBuilder::data(const StringBuilder *self)
+   * @param self The StringBuilder.
+   * @return A new Data with the accumulated text.
+   * @memberof StringBuilder
+   */
+  Data *(*data)(const StringBuilder *self);
+
+  /**
+   * @fn StringBuilder *StringBuilder::init(StringBuilder *self)
+   * @brief Initializes this StringBuilder.
+   * @param self The StringBuilder.
+   * @return The initialized StringBuilder, or `NULL` on error.
+   * @memberof StringBuilder
+   */
+  StringBuilder *(*init)(StringBuilder *self);
+
+  /**
+   * @fn String *StringBuilder::string(const StringBuilder *self)
+   * @param self The StringBuilder.
+   * @return A new String with the accumulated text.
+   * @memberof StringBuilder
+   */
+  String *(*string)(const StringBuilder *self);
+
+  /**
+   * @fn bool StringBuilder::writeToFileDescriptor(const StringBuilder *self, int fd)
+   * @brief Writes the accumulated text to `fd`, without flattening it.
+   * @param self The StringBuilder.
+   * @param fd The file descriptor.
+   * @return `true` on success, `false` on error, in which case `errno` is set.
+   * @remarks The chunks are written with `writev`, so that each system call writes many of them.
+   * @memberof StringBuilder
+   */
+  bool (*writeToFileDescriptor)(const StringBuilder *self, int fd);
+};
+
+/**
+ * @fn Class *StringBuilder::_StringBuilder(void)
+ * @brief The StringBuilder archetype.
+ * @return The StringBuilder Class.
+ * @memberof StringBuilder
+ */
+OBJECTIVELY_EXPORT Class *_StringBuilder(void);
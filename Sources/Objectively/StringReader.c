@@ -27,6 +27,7 @@
 #include <string.h>
 #include <wchar.h>
 
+#include "Slice.h"
 #include "StringReader.h"
 
 #define _Class _StringReader
@@ -121,10 +122,11 @@ static Unicode stringReaderRead(StringReader *self) {
 }
 
 /**
- * @fn int StringReader::readToken(StringReader *self, const Unicode *charset, Unicode *stop)
- * @memberof StringReader
+ * @brief Reads a token, as `StringReader::readToken` does.
+ * @return The Range of the token within the String, which is empty if the StringReader is
+ * exhausted.
  */
-static String *readToken(StringReader *self, const Unicode *charset, Unicode *stop) {
+static Range readTokenRange(StringReader *self, const Unicode *charset, Unicode *stop) {
 
   while (true) {
     const Unicode c = $(self, peek);
@@ -147,17 +149,40 @@ static String *readToken(StringReader *self, const Unicode *charset, Unicode *st
     $(self, read);
   }
 
-  if (self->head - start > 0) {
-    const Range range = {
-      .location = start - self->string->chars,
-      .length = self->head - start
-    };
+  return (Range) {
+    .location = start - self->string->chars,
+    .length = self->head - start
+  };
+}
+
+/**
+ * @fn int StringReader::readToken(StringReader *self, const Unicode *charset, Unicode *stop)
+ * @memberof StringReader
+ */
+static String *readToken(StringReader *self, const Unicode *charset, Unicode *stop) {
+
+  const Range range = readTokenRange(self, charset, stop);
+  if (range.length) {
     return $(self->string, substring, range);
   }
 
   return NULL;
 }
 
+/**
+ * @fn Slice *StringReader::readTokenSlice(StringReader *self, const Unicode *charset, Unicode *stop)
+ * @memberof StringReader
+ */
+static Slice *readTokenSlice(StringReader *self, const Unicode *charset, Unicode *stop) {
+
+  const Range range = readTokenRange(self, charset, stop);
+  if (range.length) {
+    return $(self->string, slice, range);
+  }
+
+  return NULL;
+}
+
 /**
  * @fn void StringReader::reset(StringReader *self)
  * @memberof StringReader
@@ -182,6 +207,7 @@ static void initialize(Class *clazz) {
   ((StringReaderInterface *) clazz->interface)->peek = peek;
   ((StringReaderInterface *) clazz->interface)->read = stringReaderRead;
   ((StringReaderInterface *) clazz->interface)->readToken = readToken;
+  ((StringReaderInterface *) clazz->interface)->readTokenSlice = readTokenSlice;
   ((StringReaderInterface *) clazz->interface)->reset = reset;
 }
 
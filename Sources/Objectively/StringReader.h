@@ -139,6 +139,18 @@ struct StringReaderInterface {
    */
   String *(*readToken)(StringReader *self, const Unicode *charset, Unicode *stop);
 
+  /**
+   * @fn Slice *StringReader::readTokenSlice(StringReader *self, const Unicode *charset, Unicode *stop)
+   * @brief Reads a token, as `StringReader::readToken` does, as a Slice of the String to read.
+   * @param self The StringReader.
+   * @param charset The array of potential `stop` characters.
+   * @param stop Optionally returns the stop character from `charset`.
+   * @return The token accumulated before `stop`, or `NULL` if the StringReader is exhausted.
+   * @remarks Tokenizing with Slices does not copy the String to read.
+   * @memberof StringReader
+   */
+  Slice *(*readTokenSlice)(StringReader *self, const Unicode *charset, Unicode *stop);
+
   /**
    * @fn void StringReader::reset(StringReader *self)
    * @brief Resets this StringReader, placing the `head` before the beginning of the String.
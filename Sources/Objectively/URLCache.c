@@ -75,18 +75,25 @@ static bool stringEqualsIgnoreCaseN(const char *a, const char *b, size_t length)
 
 /**
  * @brief Returns the value for the specified HTTP header field, case-insensitively.
+ * @details A header named exactly `field` is found by a hashed lookup. Otherwise, each header
+ * name is compared without regard to case.
  */
-static const String *headerValueForField(const Dictionary *headers, const char *field) {
+static const String *headerValueForField(const Dictionary *headers, const String *field) {
 
   if (headers && field) {
 
+    const String *value = $(headers, objectForKey, (ident) field);
+    if (value) {
+      return value;
+    }
+
     Array *keys = $(headers, allKeys);
     for (size_t i = 0; i < keys->count; i++) {
 
       const String *key = $(keys, objectAtIndex, i);
-      if (stringEqualsIgnoreCase(key->chars, field)) {
+      if (stringEqualsIgnoreCase(key->chars, field->chars)) {
 
-        const String *value = $(headers, objectForKey, (ident) key);
+        value = $(headers, objectForKey, (ident) key);
         release(keys);
         return value;
       }
@@ -172,12 +179,12 @@ static bool requestIsCacheable(const URLRequest *request) {
       return false;
   }
 
-  const String *cacheControl = headerValueForField(request->httpHeaders, "Cache-Control");
+  const String *cacheControl = headerValueForField(request->httpHeaders, strlit("Cache-Control"));
   if (cacheControl && cacheControlDisablesCaching(cacheControl->chars)) {
     return false;
   }
 
-  const String *pragma = headerValueForField(request->httpHeaders, "Pragma");
+  const String *pragma = headerValueForField(request->httpHeaders, strlit("Pragma"));
   if (pragma && stringEqualsIgnoreCase(pragma->chars, "no-cache")) {
     return false;
   }
@@ -194,12 +201,12 @@ static bool responseIsCacheable(const URLResponse *response) {
     return false;
   }
 
-  const String *cacheControl = headerValueForField(response->httpHeaders, "Cache-Control");
+  const String *cacheControl = headerValueForField(response->httpHeaders, strlit("Cache-Control"));
   if (cacheControl && cacheControlDisablesCaching(cacheControl->chars)) {
     return false;
   }
 
-  const String *pragma = headerValueForField(response->httpHeaders, "Pragma");
+  const String *pragma = headerValueForField(response->httpHeaders, strlit("Pragma"));
   if (pragma && stringEqualsIgnoreCase(pragma->chars, "no-cache")) {
     return false;
   }
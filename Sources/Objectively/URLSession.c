@@ -343,7 +343,7 @@ static URLSession *sharedInstance(void) {
   static Once once;
 
   do_once(&once, {
-    _sharedInstance = $(alloc(URLSession), init);
+    _sharedInstance = immortalize($(alloc(URLSession), init));
   });
 
   return _sharedInstance;
@@ -380,7 +380,10 @@ static URLSessionUploadTask *uploadTaskWithRequest(URLSession *self, URLRequest
  */
 static void destroy(Class *clazz) {
 
-  _sharedInstance = release(_sharedInstance);
+  if (_sharedInstance) {
+    $((Object *) _sharedInstance, dealloc);
+    _sharedInstance = NULL;
+  }
 
   curl_global_cleanup();
 }
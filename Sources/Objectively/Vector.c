@@ -28,11 +28,35 @@
 #include <string.h>
 
 #include "Hash.h"
+#include "OperationQueue.h"
 #include "Vector.h"
 
 #define _Class _Vector
 
-#define VECTOR_CHUNK_SIZE 64
+/**
+ * @brief The capacity of a Vector's first allocation. Each after it doubles.
+ */
+#define VECTOR_MIN_CAPACITY 16
+
+/**
+ * @brief Ensures that this Vector has room for `count` elements.
+ * @details Capacity grows geometrically, so that repeated additions are amortized.
+ */
+static void grow(Vector *self, size_t count) {
+
+  if (count > self->capacity) {
+
+    size_t capacity = self->capacity << 1;
+    if (capacity < VECTOR_MIN_CAPACITY) {
+      capacity = VECTOR_MIN_CAPACITY;
+    }
+    if (capacity < count) {
+      capacity = count;
+    }
+
+    $(self, reserveCapacity, capacity);
+  }
+}
 
 #pragma mark - Object
 
@@ -77,12 +101,7 @@ static int hash(const Object *self) {
 
   Vector *this = (Vector *) self;
 
-  const Range range = {
-    .location = 0,
-    .length = this->count * this->size
-  };
-
-  return HashForBytes(HASH_SEED, this->elements, range);
+  return (int) Hash64ForBytes(Hash64Seed(), this->elements, this->count * this->size);
 }
 
 /**
@@ -115,21 +134,26 @@ static bool isEqual(const Object *self, const Object *other) {
  */
 static void add(Vector *self, const ident element) {
 
-  if (self->count == self->capacity) {
+  grow(self, self->count + 1);
 
-    self->capacity += VECTOR_CHUNK_SIZE;
+  memcpy(self->elements + self->count * self->size, element, self->size);
+  self->count++;
+}
 
-    if (self->elements) {
-      self->elements = realloc(self->elements, self->capacity * self->size);
-    } else {
-      self->elements = calloc(self->capacity, self->size);
-    }
+/**
+ * @fn void Vector::addElements(Vector *self, size_t count, const ident elements)
+ * @memberof Vector
+ */
+static void addElements(Vector *self, size_t count, const ident elements) {
 
-    assert(self->elements);
-  }
+  if (count) {
+    assert(elements);
 
-  memcpy(self->elements + self->count * self->size, element, self->size);
-  self->count++;
+    grow(self, self->count + count);
+
+    memcpy(self->elements + self->count * self->size, elements, count * self->size);
+    self->count += count;
+  }
 }
 
 /**
@@ -153,11 +177,20 @@ static void filter(Vector *self, Predicate predicate, ident data) {
 
   assert(predicate);
 
+  size_t count = 0;
   for (size_t i = 0; i < self->count; i++) {
-    if (!predicate(self->elements + i * self->size, data)) {
-      $(self, removeAt, i);
+    ident element = self->elements + i * self->size;
+    if (predicate(element, data)) {
+      if (count < i) {
+        memcpy(self->elements + count * self->size, element, self->size);
+      }
+      count++;
+    } else if (self->destroy) {
+      self->destroy(element);
     }
   }
+
+  self->count = count;
 }
 
 /**
@@ -200,6 +233,7 @@ static Vector *initWithElements(Vector *self, size_t size, size_t count, ident e
 
   self = $(self, initWithSize, size);
   if (self) {
+    self->capacity = count;
     self->count = count;
     self->elements = elements;
   }
@@ -227,15 +261,29 @@ static Vector *initWithSize(Vector *self, size_t size) {
  */
 static void insert(Vector *self, const ident element, size_t index) {
 
+  $(self, insertElements, 1, element, index);
+}
+
+/**
+ * @fn void Vector::insertElements(Vector *self, size_t count, const ident elements, size_t index)
+ * @memberof Vector
+ */
+static void insertElements(Vector *self, size_t count, const ident elements, size_t index) {
+
   assert(index <= self->count);
 
-  $(self, add, element);
+  if (count) {
+    assert(elements);
 
-  for (size_t i = self->count - 1; i > index; i--) {
-    memcpy(self->elements + i * self->size, self->elements + (i - 1) * self->size, self->size);
-  }
+    grow(self, self->count + count);
+
+    memmove(self->elements + (index + count) * self->size,
+            self->elements + index * self->size,
+            (self->count - index) * self->size);
 
-  memcpy(self->elements + index * self->size, element, self->size);
+    memcpy(self->elements + index * self->size, elements, count * self->size);
+    self->count += count;
+  }
 }
 
 /**
@@ -247,6 +295,8 @@ static Vector *mappedVector(const Vector *self, Functor functor, ident data) {
   assert(functor);
 
   Vector *vector = $(alloc(Vector), initWithSize, self->size);
+  $(vector, reserveCapacity, self->count);
+
   for (size_t i = 0; i < self->count; i++) {
     ident result = functor(self->elements + i * self->size, data);
     $(vector, add, result);
@@ -254,6 +304,197 @@ static Vector *mappedVector(const Vector *self, Functor functor, ident data) {
   return vector;
 }
 
+/**
+ * @brief The cache line size, on which the `parallel` methods split the spans they write.
+ */
+#define VECTOR_CACHE_LINE 64
+
+/**
+ * @brief Vectors are split into chunks of at least this many elements for the `parallel` methods.
+ */
+#define VECTOR_PARALLEL_CHUNK 0x400
+
+/**
+ * @brief The most chunks the `parallel` methods will split a Vector into.
+ */
+#define VECTOR_PARALLEL_CHUNKS 64
+
+/**
+ * @brief A contiguous span of a Vector, processed by one Operation of a `parallel` method.
+ * @details Tasks are written by different threads, and so are padded to a cache line apiece.
+ */
+typedef struct {
+  const Vector *vector;
+  ident out;
+  size_t lo, hi;
+  union {
+    Functor functor;
+    Reducer reducer;
+  };
+  ident data;
+  ident accumulator;
+} __attribute__((aligned(VECTOR_CACHE_LINE))) ParallelTask;
+
+/**
+ * @brief Splits the elements of `self` into chunks of at least `VECTOR_PARALLEL_CHUNK`.
+ * @param self The Vector.
+ * @param out The elements to be written, or `NULL`. Chunks are split on cache lines of `out`, so
+ * that no two chunks write the same line.
+ * @param bounds Receives the bounds of each chunk, which spans `bounds[i]` to `bounds[i + 1]`.
+ * @return The number of chunks.
+ */
+static size_t chunk(const Vector *self, const ident out, size_t *bounds) {
+
+  const size_t chunks = clamp(self->count / VECTOR_PARALLEL_CHUNK, (size_t) 1, (size_t) VECTOR_PARALLEL_CHUNKS);
+
+  bounds[0] = 0;
+
+  for (size_t i = 1; i < chunks; i++) {
+    size_t bound = i * self->count / chunks;
+    if (out) {
+      const uintptr_t line = (uintptr_t) (out + bound * self->size) & ~((uintptr_t) VECTOR_CACHE_LINE - 1);
+      bound = (line - (uintptr_t) out) / self->size;
+    }
+    bounds[i] = max(bound, bounds[i - 1]);
+  }
+
+  bounds[chunks] = self->count;
+
+  return chunks;
+}
+
+/**
+ * @brief Runs `count` tasks with `function`, all but the last on `queue`, and the last on the
+ * calling thread, and then waits for them all to finish.
+ * @param queue The OperationQueue, or `NULL` for the shared queue.
+ */
+static void dispatch(OperationQueue *queue, OperationFunction function, ParallelTask *tasks, size_t count) {
+
+  Operation *operations[VECTOR_PARALLEL_CHUNKS];
+
+  if (count > 1) {
+    if (queue == NULL) {
+      queue = $$(OperationQueue, sharedQueue);
+    }
+
+    assert(queue != $$(OperationQueue, currentQueue));
+
+    for (size_t i = 0; i < count - 1; i++) {
+      operations[i] = $(queue, addOperationWithFunction, function, tasks + i);
+    }
+  }
+
+  Operation *operation = $(alloc(Operation), initWithFunction, function, tasks + count - 1);
+  $(operation, start);
+  release(operation);
+
+  for (size_t i = 0; i < count - 1; i++) {
+    $(operations[i], waitUntilFinished);
+    release(operations[i]);
+  }
+}
+
+/**
+ * @brief OperationFunction for `parallelMappedVector`.
+ */
+static void parallelMappedVector_map(Operation *operation) {
+
+  const ParallelTask *task = operation->data;
+  const size_t size = task->vector->size;
+
+  for (size_t i = task->lo; i < task->hi; i++) {
+    const ident result = task->functor(task->vector->elements + i * size, task->data);
+    memcpy(task->out + i * size, result, size);
+  }
+}
+
+/**
+ * @fn Vector *Vector::parallelMappedVector(const Vector *self, Functor functor, ident data, OperationQueue *queue)
+ * @memberof Vector
+ */
+static Vector *parallelMappedVector(const Vector *self, Functor functor, ident data, OperationQueue *queue) {
+
+  assert(functor);
+
+  Vector *vector = $(alloc(Vector), initWithSize, self->size);
+  $(vector, reserveCapacity, self->count);
+
+  ParallelTask tasks[VECTOR_PARALLEL_CHUNKS];
+  size_t bounds[VECTOR_PARALLEL_CHUNKS + 1];
+
+  const size_t chunks = chunk(self, vector->elements, bounds);
+
+  for (size_t i = 0; i < chunks; i++) {
+    tasks[i] = (ParallelTask) {
+      .vector = self,
+      .out = vector->elements,
+      .lo = bounds[i],
+      .hi = bounds[i + 1],
+      .functor = functor,
+      .data = data
+    };
+  }
+
+  dispatch(queue, parallelMappedVector_map, tasks, chunks);
+
+  vector->count = self->count;
+
+  return vector;
+}
+
+/**
+ * @brief OperationFunction for `parallelReduce`.
+ */
+static void parallelReduce_reduce(Operation *operation) {
+
+  ParallelTask *task = operation->data;
+  const size_t size = task->vector->size;
+
+  ident accumulator = task->accumulator;
+
+  for (size_t i = task->lo; i < task->hi; i++) {
+    accumulator = task->reducer(task->vector->elements + i * size, accumulator, task->data);
+  }
+
+  task->accumulator = accumulator;
+}
+
+/**
+ * @fn ident Vector::parallelReduce(const Vector *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue)
+ * @memberof Vector
+ */
+static ident parallelReduce(const Vector *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue) {
+
+  assert(reducer);
+  assert(combiner);
+
+  ParallelTask tasks[VECTOR_PARALLEL_CHUNKS];
+  size_t bounds[VECTOR_PARALLEL_CHUNKS + 1];
+
+  const size_t chunks = chunk(self, NULL, bounds);
+
+  for (size_t i = 0; i < chunks; i++) {
+    tasks[i] = (ParallelTask) {
+      .vector = self,
+      .lo = bounds[i],
+      .hi = bounds[i + 1],
+      .reducer = reducer,
+      .data = data,
+      .accumulator = accumulator
+    };
+  }
+
+  dispatch(queue, parallelReduce_reduce, tasks, chunks);
+
+  accumulator = tasks[0].accumulator;
+
+  for (size_t i = 1; i < chunks; i++) {
+    accumulator = combiner(tasks[i].accumulator, accumulator, data);
+  }
+
+  return accumulator;
+}
+
 /**
  * @fn ident Vector::reduce(const Vector *self, Reducer reducer, ident accumulator, ident data)
  * @memberof Vector
@@ -324,6 +565,21 @@ static void removeAtFast(Vector *self, size_t index) {
   self->count--;
 }
 
+/**
+ * @fn void Vector::reserveCapacity(Vector *self, size_t capacity)
+ * @memberof Vector
+ */
+static void reserveCapacity(Vector *self, size_t capacity) {
+
+  if (capacity > self->capacity) {
+
+    self->elements = realloc(self->elements, capacity * self->size);
+    assert(self->elements);
+
+    self->capacity = capacity;
+  }
+}
+
 /**
  * @fn void Vector::resize(Vector *self, size_t capacity)
  * @memberof Vector
@@ -343,6 +599,26 @@ static void resize(Vector *self, size_t capacity) {
   self->count = min(self->count, self->capacity);
 }
 
+/**
+ * @fn void Vector::shrinkToFit(Vector *self)
+ * @memberof Vector
+ */
+static void shrinkToFit(Vector *self) {
+
+  if (self->capacity > self->count) {
+
+    if (self->count) {
+      self->elements = realloc(self->elements, self->count * self->size);
+      assert(self->elements);
+    } else {
+      free(self->elements);
+      self->elements = NULL;
+    }
+
+    self->capacity = self->count;
+  }
+}
+
 #if defined(__APPLE__)
 
 /**
@@ -396,6 +672,97 @@ static void sort(Vector *self, Comparator comparator) {
 
 #endif
 
+/**
+ * @brief Runs shorter than this are insertion sorted before they are merged.
+ */
+#define VECTOR_SORT_RUN 16
+
+/**
+ * @brief Stably merges the sorted runs `in[lo, mid)` and `in[mid, hi)` into `out[lo, hi)`.
+ */
+static void mergeRuns(const Vector *self, ident in, ident out, size_t lo, size_t mid, size_t hi, Comparator comparator) {
+
+  const size_t size = self->size;
+
+  if (mid == lo || mid == hi || comparator(in + (mid - 1) * size, in + mid * size) <= OrderSame) {
+    memcpy(out + lo * size, in + lo * size, (hi - lo) * size);
+    return;
+  }
+
+  ident a = in + lo * size, b = in + mid * size, o = out + lo * size;
+  const ident aEnd = b, bEnd = in + hi * size;
+
+  while (a < aEnd && b < bEnd) {
+    if (comparator(a, b) > OrderSame) {
+      memcpy(o, b, size);
+      b += size;
+    } else {
+      memcpy(o, a, size);
+      a += size;
+    }
+    o += size;
+  }
+
+  memcpy(o, a, aEnd - a);
+  memcpy(o + (aEnd - a), b, bEnd - b);
+}
+
+/**
+ * @fn void Vector::stableSort(Vector *self, Comparator comparator)
+ * @memberof Vector
+ */
+static void stableSort(Vector *self, Comparator comparator) {
+
+  assert(comparator);
+
+  if (self->count < 2) {
+    return;
+  }
+
+  const size_t size = self->size;
+
+  ident buffer = malloc((self->count + 1) * size);
+  assert(buffer);
+
+  ident element = buffer + self->count * size;
+
+  for (size_t lo = 0; lo < self->count; lo += VECTOR_SORT_RUN) {
+    const size_t hi = min(lo + VECTOR_SORT_RUN, self->count);
+
+    for (size_t i = lo + 1; i < hi; i++) {
+      memcpy(element, self->elements + i * size, size);
+
+      size_t j = i;
+      while (j > lo && comparator(self->elements + (j - 1) * size, element) > OrderSame) {
+        j--;
+      }
+
+      if (j < i) {
+        memmove(self->elements + (j + 1) * size, self->elements + j * size, (i - j) * size);
+        memcpy(self->elements + j * size, element, size);
+      }
+    }
+  }
+
+  ident in = self->elements, out = buffer;
+
+  for (size_t width = VECTOR_SORT_RUN; width < self->count; width <<= 1) {
+    for (size_t lo = 0; lo < self->count; lo += width << 1) {
+      mergeRuns(self, in, out, lo, min(lo + width, self->count), min(lo + (width << 1), self->count), comparator);
+    }
+
+    ident swap = in;
+    in = out;
+    out = swap;
+  }
+
+  if (in != self->elements) {
+    memcpy(self->elements, in, self->count * size);
+  }
+
+  free(buffer);
+}
+
 /**
  * @fn Vector *Vector::vectorWithElements(size_t size, size_t count, ident elements)
  * @memberof Vector
@@ -425,6 +792,7 @@ static void initialize(Class *clazz) {
   ((ObjectInterface *) clazz->interface)->isEqual = isEqual;
 
   ((VectorInterface *) clazz->interface)->add = add;
+  ((VectorInterface *) clazz->interface)->addElements = addElements;
   ((VectorInterface *) clazz->interface)->enumerate = enumerate;
   ((VectorInterface *) clazz->interface)->filter = filter;
   ((VectorInterface *) clazz->interface)->find = find;
@@ -432,13 +800,19 @@ static void initialize(Class *clazz) {
   ((VectorInterface *) clazz->interface)->initWithElements = initWithElements;
   ((VectorInterface *) clazz->interface)->initWithSize = initWithSize;
   ((VectorInterface *) clazz->interface)->insert = insert;
+  ((VectorInterface *) clazz->interface)->insertElements = insertElements;
   ((VectorInterface *) clazz->interface)->mappedVector = mappedVector;
+  ((VectorInterface *) clazz->interface)->parallelMappedVector = parallelMappedVector;
+  ((VectorInterface *) clazz->interface)->parallelReduce = parallelReduce;
   ((VectorInterface *) clazz->interface)->reduce = reduce;
   ((VectorInterface *) clazz->interface)->removeAll = removeAll;
   ((VectorInterface *) clazz->interface)->removeAt = removeAt;
   ((VectorInterface *) clazz->interface)->removeAtFast = removeAtFast;
+  ((VectorInterface *) clazz->interface)->reserveCapacity = reserveCapacity;
   ((VectorInterface *) clazz->interface)->resize = resize;
+  ((VectorInterface *) clazz->interface)->shrinkToFit = shrinkToFit;
   ((VectorInterface *) clazz->interface)->sort = sort;
+  ((VectorInterface *) clazz->interface)->stableSort = stableSort;
   ((VectorInterface *) clazz->interface)->vectorWithElements = vectorWithElements;
   ((VectorInterface *) clazz->interface)->vectorWithSize = vectorWithSize;
 }
@@ -35,6 +35,8 @@
 typedef struct Vector Vector;
 typedef struct VectorInterface VectorInterface;
 
+typedef struct OperationQueue OperationQueue;
+
 /**
  * @brief The VectorEnumerator function type.
  * @param vector The Vector.
@@ -121,6 +123,16 @@ struct VectorInterface {
    */
   void (*add)(Vector *self, const ident element);
 
+  /**
+   * @fn void Vector::addElements(Vector *self, size_t count, const ident elements)
+   * @brief Adds `count` contiguous elements to this Vector, growing it at most once.
+   * @param self The Vector.
+   * @param count The count of elements.
+   * @param elements The elements to add.
+   * @memberof Vector
+   */
+  void (*addElements)(Vector *self, size_t count, const ident elements);
+
   /**
    * @fn void Vector::enumerate(const Vector *self, VectorEnumerator enumerator, ident data)
    * @brief Enumerates the elements of this Vector with the given function.
@@ -192,6 +204,17 @@ struct VectorInterface {
    */
   void (*insert)(Vector *self, const ident element, size_t index);
 
+  /**
+   * @fn void Vector::insertElements(Vector *self, size_t count, const ident elements, size_t index)
+   * @brief Inserts `count` contiguous elements at the specified index.
+   * @param self The Vector.
+   * @param count The count of elements.
+   * @param elements The elements to insert.
+   * @param index The index at which to insert.
+   * @memberof Vector
+   */
+  void (*insertElements)(Vector *self, size_t count, const ident elements, size_t index);
+
   /**
    * @fn Vector *Vector::mappedVector(const Vector *self, Functor functor, ident data)
    * @brief Returns a new Vector containing the elements of this Vector transformed by `functor`.
@@ -203,6 +226,38 @@ struct VectorInterface {
    */
   Vector *(*mappedVector)(const Vector *self, Functor functor, ident data);
 
+  /**
+   * @fn Vector *Vector::parallelMappedVector(const Vector *self, Functor functor, ident data, OperationQueue *queue)
+   * @brief Returns a new Vector containing the elements of this Vector transformed by `functor`,
+   * splitting the work across `queue`.
+   * @param self The Vector.
+   * @param functor The Functor, which must be safe to call from several threads at once.
+   * @param data User data.
+   * @param queue The OperationQueue, or `NULL` for the shared queue.
+   * @return A new mapped Vector.
+   * @remarks This Vector is split into contiguous chunks, one Operation apiece, on cache lines of
+   * the output. The calling thread runs the last chunk itself, and then waits for the rest. This
+   * method must not be called from an Operation running on `queue`.
+   * @memberof Vector
+   */
+  Vector *(*parallelMappedVector)(const Vector *self, Functor functor, ident data, OperationQueue *queue);
+
+  /**
+   * @fn ident Vector::parallelReduce(const Vector *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue)
+   * @brief Reduces this Vector, splitting the work across `queue`.
+   * @param self The Vector.
+   * @param reducer The Reducer, which must be safe to call from several threads at once.
+   * @param combiner The associative Reducer which combines the partial reduction of each chunk,
+   * in order, into the accumulator.
+   * @param accumulator The initial accumulator value of each chunk, which must be an identity of
+   * `combiner`.
+   * @param data User data.
+   * @param queue The OperationQueue, or `NULL` for the shared queue.
+   * @return The reduction result.
+   * @memberof Vector
+   */
+  ident (*parallelReduce)(const Vector *self, Reducer reducer, Reducer combiner, ident accumulator, ident data, OperationQueue *queue);
+
   /**
    * @fn ident Vector::reduce(const Vector *self, Reducer reducer, ident accumulator, ident data)
    * @param self The Vector.
@@ -243,6 +298,15 @@ struct VectorInterface {
    */
   void (*removeAtFast)(Vector *self, size_t index);
 
+  /**
+   * @fn void Vector::reserveCapacity(Vector *self, size_t capacity)
+   * @brief Ensures that this Vector can hold `capacity` elements without growing.
+   * @param self The Vector.
+   * @param capacity The desired capacity.
+   * @memberof Vector
+   */
+  void (*reserveCapacity)(Vector *self, size_t capacity);
+
   /**
    * @fn void Vector::resize(Vector *self, size_t capacity)
    * @brief Resizes this Vector to the specified capacity.
@@ -252,15 +316,33 @@ struct VectorInterface {
    */
   void (*resize)(Vector *self, size_t capacity);
 
+  /**
+   * @fn void Vector::shrinkToFit(Vector *self)
+   * @brief Releases any capacity this Vector holds beyond its count.
+   * @param self The Vector.
+   * @memberof Vector
+   */
+  void (*shrinkToFit)(Vector *self);
+
   /**
   * @fn void Vector::sort(Vector *self, Comparator comparator)
   * @brief Sorts this Vector in place using `comparator`.
   * @param self The Vector.
   * @param comparator A Comparator.
+  * @remarks The sort is not stable. Use `stableSort` to preserve the order of equal elements.
   * @memberof Vector
   */
   void (*sort)(Vector *self, Comparator comparator);
 
+  /**
+   * @fn void Vector::stableSort(Vector *self, Comparator comparator)
+   * @brief Stably sorts this Vector in place using `comparator`.
+   * @param self The Vector.
+   * @param comparator A Comparator, which is passed pointers to the elements.
+   * @memberof Vector
+   */
+  void (*stableSort)(Vector *self, Comparator comparator);
+
   /**
    * @static
    * @fn Vector *Vector::vectorWithElements(size_t size, size_t count, ident elements)
@@ -34,6 +34,10 @@ static bool predicate(const ident obj, ident data) {
   return obj == data;
 }
 
+static bool isEven(const ident obj, ident data) {
+  return $((Number *) obj, intValue) % 2 == 0;
+}
+
 static ident functor(const ident obj, ident data) {
   return $((Object *) obj, copy);
 }
@@ -234,12 +238,335 @@ START_TEST(array_mutation) {
 
 } END_TEST
 
+START_TEST(array_capacity) {
+
+  Object *objects[5];
+  for (size_t i = 0; i < lengthof(objects); i++) {
+    objects[i] = $(alloc(Object), init);
+  }
+
+  Array *array = $$(Array, arrayWithObjects, objects[0], objects[1], NULL);
+  ck_assert_int_eq(2, array->count);
+  ck_assert_int_eq(2, array->capacity);
+
+  $(array, addObjectsWithCount, 3, (ident *) objects + 2);
+  ck_assert_int_eq(5, array->count);
+  ck_assert_int_ge(array->capacity, 5);
+
+  for (size_t i = 0; i < lengthof(objects); i++) {
+    ck_assert_ptr_eq(objects[i], $(array, objectAtIndex, i));
+    ck_assert_int_eq(2, objects[i]->referenceCount);
+  }
+
+  $(array, reserveCapacity, 100);
+  ck_assert_int_eq(100, array->capacity);
+
+  $(array, shrinkToFit);
+  ck_assert_int_eq(5, array->capacity);
+
+  Array *copy = (Array *) $((Object *) array, copy);
+
+  IndexSet *indexes = $(alloc(IndexSet), init);
+  $(indexes, addIndex, 0);
+  $(indexes, addIndex, 3);
+  $(indexes, addIndex, 7);
+
+  ident inserted[] = { objects[4], objects[3], objects[2] };
+  $(array, insertObjectsAtIndexes, inserted, indexes);
+  ck_assert_int_eq(8, array->count);
+
+  Object *expected[] = {
+    objects[4], objects[0], objects[1], objects[3], objects[2], objects[3], objects[4], objects[2]
+  };
+
+  for (size_t i = 0; i < lengthof(expected); i++) {
+    ck_assert_ptr_eq(expected[i], $(array, objectAtIndex, i));
+  }
+
+  ck_assert_int_eq(5, copy->count);
+  ck_assert_ptr_eq(objects[0], $(copy, objectAtIndex, 0));
+  ck_assert_int_eq(4, objects[2]->referenceCount);
+
+  $(array, shrinkToFit);
+  $(array, addObjectsFromArray, array);
+  ck_assert_int_eq(16, array->count);
+
+  for (size_t i = 0; i < lengthof(expected); i++) {
+    ck_assert_ptr_eq(expected[i], $(array, objectAtIndex, i));
+    ck_assert_ptr_eq(expected[i], $(array, objectAtIndex, i + lengthof(expected)));
+  }
+
+  release(indexes);
+  release(copy);
+  release(array);
+
+  for (size_t i = 0; i < lengthof(objects); i++) {
+    ck_assert_int_eq(1, objects[i]->referenceCount);
+    release(objects[i]);
+  }
+
+} END_TEST
+
+START_TEST(array_removal) {
+
+  Object *objects[8];
+  for (size_t i = 0; i < lengthof(objects); i++) {
+    objects[i] = $(alloc(Object), init);
+  }
+
+  Array *array = $(alloc(Array), initWithCapacity, lengthof(objects));
+  $(array, addObjectsWithCount, lengthof(objects), (ident *) objects);
+
+  Array *copy = (Array *) $((Object *) array, copy);
+
+  size_t removals[] = { 0, 2, 3, 7 };
+  IndexSet *indexes = $(alloc(IndexSet), initWithIndexes, removals, lengthof(removals));
+
+  $(array, removeObjectsAtIndexes, indexes);
+  ck_assert_int_eq(4, array->count);
+  ck_assert_ptr_eq(objects[1], $(array, objectAtIndex, 0));
+  ck_assert_ptr_eq(objects[4], $(array, objectAtIndex, 1));
+  ck_assert_ptr_eq(objects[5], $(array, objectAtIndex, 2));
+  ck_assert_ptr_eq(objects[6], $(array, objectAtIndex, 3));
+
+  ck_assert_int_eq(lengthof(objects), copy->count);
+  ck_assert_int_eq(2, objects[0]->referenceCount);
+  ck_assert_int_eq(3, objects[1]->referenceCount);
+
+  $(array, removeObjectsInRange, (Range) { 1, 2 });
+  ck_assert_int_eq(2, array->count);
+  ck_assert_ptr_eq(objects[1], $(array, objectAtIndex, 0));
+  ck_assert_ptr_eq(objects[6], $(array, objectAtIndex, 1));
+  ck_assert_int_eq(2, objects[4]->referenceCount);
+
+  $(array, removeObjectsInRange, (Range) { 0, 0 });
+  ck_assert_int_eq(2, array->count);
+
+  release(indexes);
+  release(array);
+  release(copy);
+
+  for (size_t i = 0; i < lengthof(objects); i++) {
+    ck_assert_int_eq(1, objects[i]->referenceCount);
+    release(objects[i]);
+  }
+
+  array = $(alloc(Array), init);
+  for (int i = 0; i < 10; i++) {
+    Number *number = $$(Number, numberWithValue, i);
+    $(array, addObject, number);
+    release(number);
+  }
+
+  copy = (Array *) $((Object *) array, copy);
+
+  const size_t count = $(array, partition, isEven, NULL);
+  ck_assert_int_eq(5, count);
+  ck_assert_int_eq(10, array->count);
+
+  const int partitioned[] = { 0, 2, 4, 6, 8, 1, 3, 5, 7, 9 };
+  for (size_t i = 0; i < lengthof(partitioned); i++) {
+    ck_assert_int_eq(partitioned[i], $((Number *) $(array, objectAtIndex, i), intValue));
+    ck_assert_int_eq(i, $((Number *) $(copy, objectAtIndex, i), intValue));
+  }
+
+  $(copy, filter, isEven, NULL);
+  ck_assert_int_eq(5, copy->count);
+  for (size_t i = 0; i < copy->count; i++) {
+    ck_assert_int_eq(i * 2, $((Number *) $(copy, objectAtIndex, i), intValue));
+  }
+
+  ck_assert_int_eq(5, $(array, partition, isEven, NULL));
+  ck_assert_int_eq(8, $((Number *) $(array, objectAtIndex, 4), intValue));
+
+  release(copy);
+  release(array);
+
+} END_TEST
+
+static Order byKey(const ident obj1, const ident obj2) {
+  return $((Number *) obj1, intValue) / 10000 - $((Number *) obj2, intValue) / 10000;
+}
+
+START_TEST(array_sort) {
+
+  Array *array = $$(Array, array);
+
+  for (int i = 0; i < 1000; i++) {
+    Number *number = $$(Number, numberWithValue, ((i * 7919) % 100) * 10000 + i);
+    $(array, addObject, number);
+    release(number);
+  }
+
+  $(array, stableSort, byKey);
+
+  for (size_t i = 1; i < array->count; i++) {
+    const int a = $((Number *) $(array, objectAtIndex, i - 1), intValue);
+    const int b = $((Number *) $(array, objectAtIndex, i), intValue);
+
+    ck_assert_int_le(a / 10000, b / 10000);
+    if (a / 10000 == b / 10000) {
+      ck_assert_int_lt(a % 10000, b % 10000);
+    }
+  }
+
+  release(array);
+
+  array = $$(Array, array);
+
+  for (int i = 0; i < 200000; i++) {
+    Number *number = $$(Number, numberWithValue, rand() % 1000000);
+    $(array, addObject, number);
+    release(number);
+  }
+
+  Array *copy = (Array *) $((Object *) array, copy);
+
+  OperationQueue *queue = $(alloc(OperationQueue), initWithMaxConcurrentOperations, 4);
+
+  $(array, parallelSort, byKey, queue);
+  $(copy, stableSort, byKey);
+
+  ck_assert_int_eq(copy->count, array->count);
+  for (size_t i = 0; i < array->count; i++) {
+    ck_assert_ptr_eq($(copy, objectAtIndex, i), $(array, objectAtIndex, i));
+  }
+
+  release(queue);
+  release(copy);
+  release(array);
+
+} END_TEST
+
+static ident doubled(const ident obj, ident data) {
+  const int value = $((Number *) obj, intValue);
+  return $$(Number, numberWithValue, value * 2);
+}
+
+static ident lookup(const ident obj, ident data) {
+  const int value = $((Number *) obj, intValue);
+  return $((Array *) data, objectAtIndex, value % 10);
+}
+
+static ident sum(const ident obj, ident accumulator, ident data) {
+  return (ident) ((intptr_t) accumulator + $((Number *) obj, intValue));
+}
+
+static ident combine(const ident obj, ident accumulator, ident data) {
+  return (ident) ((intptr_t) accumulator + (intptr_t) obj);
+}
+
+START_TEST(array_parallel) {
+
+  Array *array = $$(Array, array);
+
+  intptr_t total = 0;
+  for (int i = 0; i < 100000; i++) {
+    Number *number = $$(Number, numberWithValue, i);
+    $(array, addObject, number);
+    release(number);
+    total += i;
+  }
+
+  OperationQueue *queue = $(alloc(OperationQueue), initWithMaxConcurrentOperations, 4);
+
+  OperationQueue *queues[] = { queue, NULL };
+  for (size_t q = 0; q < lengthof(queues); q++) {
+
+    Array *mapped = $(array, parallelMappedArray, doubled, NULL, queues[q]);
+    ck_assert_int_eq(array->count, mapped->count);
+    for (size_t i = 0; i < mapped->count; i++) {
+      ck_assert_int_eq(i * 2, $((Number *) $(mapped, objectAtIndex, i), intValue));
+    }
+    release(mapped);
+
+    Array *filtered = $(array, parallelFilteredArray, isEven, NULL, queues[q]);
+    ck_assert_int_eq(array->count / 2, filtered->count);
+    for (size_t i = 0; i < filtered->count; i++) {
+      ck_assert_int_eq(i * 2, $((Number *) $(filtered, objectAtIndex, i), intValue));
+    }
+    release(filtered);
+
+    const intptr_t reduced = (intptr_t) $(array, parallelReduce, sum, combine, (ident) 0, NULL, queues[q]);
+    ck_assert_int_eq(total, reduced);
+  }
+
+  Array *digits = (Array *) $((Object *) array, copy);
+  $(digits, removeObjectsInRange, (Range) { 10, digits->count - 10 });
+
+  $(array, parallelMap, lookup, digits, queue);
+  for (size_t i = 0; i < array->count; i++) {
+    ck_assert_ptr_eq($(digits, objectAtIndex, i % 10), $(array, objectAtIndex, i));
+  }
+
+  Array *empty = $$(Array, array);
+  Array *mapped = $(empty, parallelMappedArray, doubled, NULL, queue);
+  ck_assert_int_eq(0, mapped->count);
+  ck_assert_int_eq(0, (intptr_t) $(empty, parallelReduce, sum, combine, (ident) 0, NULL, queue));
+
+  release(mapped);
+  release(empty);
+  release(digits);
+  release(queue);
+  release(array);
+
+} END_TEST
+
+START_TEST(array_copy) {
+
+  Object *one = $(alloc(Object), init);
+  Object *two = $(alloc(Object), init);
+
+  Array *array = $(alloc(Array), initWithObjects, one, two, NULL);
+  Array *copy = (Array *) $((Object *) array, copy);
+
+  ck_assert_ptr_eq(array->elements, copy->elements);
+  ck_assert_int_eq(2, one->referenceCount);
+
+  $(copy, removeObject, one);
+
+  ck_assert_ptr_ne(array->elements, copy->elements);
+  ck_assert_int_eq(2, array->count);
+  ck_assert_int_eq(1, copy->count);
+  ck_assert_int_eq(2, one->referenceCount);
+  ck_assert_int_eq(3, two->referenceCount);
+
+  release(copy);
+
+  ck_assert_int_eq(2, two->referenceCount);
+
+  copy = (Array *) $((Object *) array, copy);
+
+  release(array);
+
+  ck_assert_int_eq(2, one->referenceCount);
+
+  $(copy, addObject, one);
+
+  ck_assert_int_eq(3, copy->count);
+  ck_assert_int_eq(3, one->referenceCount);
+
+  release(copy);
+
+  ck_assert_int_eq(1, one->referenceCount);
+  ck_assert_int_eq(1, two->referenceCount);
+
+  release(one);
+  release(two);
+
+} END_TEST
+
 
 int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("Array");
   tcase_add_test(tcase, array);
   tcase_add_test(tcase, array_mutation);
+  tcase_add_test(tcase, array_capacity);
+  tcase_add_test(tcase, array_removal);
+  tcase_add_test(tcase, array_sort);
+  tcase_add_test(tcase, array_parallel);
+  tcase_add_test(tcase, array_copy);
   tcase_add_test(tcase, find);
   tcase_add_test(tcase, map);
 
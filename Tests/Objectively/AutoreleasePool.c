@@ -0,0 +1,209 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+
+#include "Objectively.h"
+
+START_TEST(_autorelease) {
+
+  ck_assert($$(AutoreleasePool, currentPool) == NULL);
+
+  Object *object = $(alloc(Object), init);
+
+  AutoreleasePool *pool = $(alloc(AutoreleasePool), init);
+  ck_assert(pool != NULL);
+  ck_assert($$(AutoreleasePool, currentPool) == pool);
+
+  retain(object);
+  ck_assert(autorelease(object) == object);
+  ck_assert_int_eq(2, object->referenceCount);
+
+  for (int i = 0; i < 1000; i++) {
+    autorelease($(alloc(String), initWithFormat, "%d", i));
+  }
+
+  ck_assert_int_eq(1001, pool->count);
+
+  $(pool, drain);
+
+  ck_assert_int_eq(0, pool->count);
+  ck_assert_int_eq(1, object->referenceCount);
+
+  release(pool);
+  release(object);
+
+  ck_assert($$(AutoreleasePool, currentPool) == NULL);
+
+} END_TEST
+
+START_TEST(nesting) {
+
+  Object *object = $(alloc(Object), init);
+
+  AutoreleasePool *outer = $(alloc(AutoreleasePool), init);
+
+  autoreleasepool({
+    AutoreleasePool *inner = $$(AutoreleasePool, currentPool);
+    ck_assert(inner != outer);
+    ck_assert(inner->parent == outer);
+
+    autorelease(retain(object));
+    ck_assert_int_eq(2, object->referenceCount);
+  });
+
+  ck_assert($$(AutoreleasePool, currentPool) == outer);
+  ck_assert_int_eq(1, object->referenceCount);
+  ck_assert_int_eq(0, outer->count);
+
+  release(outer);
+  release(object);
+
+} END_TEST
+
+START_TEST(arena) {
+
+  Object *object = $(alloc(Object), init);
+
+  autoreleasepool({
+    for (int i = 0; i < 10000; i++) {
+      String *string = $(autoalloc(String), init);
+      ck_assert(string != NULL);
+      ck_assert(((Object *) string)->flags & OBJECT_ARENA);
+      ck_assert_int_eq(0, ((uintptr_t) string) % 16);
+
+      $(string, appendFormat, "%d", i);
+      ck_assert_int_eq(1, ((Object *) string)->referenceCount);
+
+      retain(string);
+      release(string);
+      release(string);
+      ck_assert_int_eq(1, ((Object *) string)->referenceCount);
+
+      String *copy = (String *) $((Object *) string, copy);
+      ck_assert_int_eq(0, ((Object *) copy)->flags);
+      release(copy);
+    }
+
+    Array *array = $(autoalloc(Array), init);
+    $(array, addObject, object);
+    ck_assert_int_eq(2, object->referenceCount);
+  });
+
+  ck_assert_int_eq(1, object->referenceCount);
+
+  release(object);
+
+} END_TEST
+
+/**
+ * @brief An Object that autoreleases another as it is deallocated.
+ */
+typedef struct {
+  Object object;
+  ObjectInterface *interface;
+  Object *other;
+} Autoreleaser;
+
+#define _Class _Autoreleaser
+
+static Class *_Autoreleaser(void);
+
+static void dealloc(Object *self) {
+
+  autorelease(((Autoreleaser *) self)->other);
+
+  super(Object, self, dealloc);
+}
+
+static void initialize(Class *clazz) {
+  ((ObjectInterface *) clazz->interface)->dealloc = dealloc;
+}
+
+static Class *_Autoreleaser(void) {
+  static Class *clazz;
+  static Once once;
+
+  do_once(&once, {
+    clazz = _initialize(&(const ClassDef) {
+      .name = "Autoreleaser",
+      .superclass = _Object(),
+      .instanceSize = sizeof(Autoreleaser),
+      .interfaceOffset = offsetof(Autoreleaser, interface),
+      .interfaceSize = sizeof(ObjectInterface),
+      .initialize = initialize,
+    });
+  });
+
+  return clazz;
+}
+
+#undef _Class
+
+START_TEST(arena_dealloc) {
+
+  Object *object = $(alloc(Object), init);
+  Object *other = $(alloc(Object), init);
+
+  AutoreleasePool *pool = $(alloc(AutoreleasePool), init);
+
+  Autoreleaser *autoreleaser = (Autoreleaser *) $((Object *) autoalloc(Autoreleaser), init);
+  autoreleaser->other = retain(object);
+
+  $(pool, drain);
+
+  ck_assert_int_eq(0, pool->count);
+  ck_assert_int_eq(1, object->referenceCount);
+
+  autoreleaser = (Autoreleaser *) $((Object *) autoalloc(Autoreleaser), init);
+  autoreleaser->other = retain(other);
+
+  release(pool);
+
+  ck_assert_int_eq(1, other->referenceCount);
+
+  release(object);
+  release(other);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+  TCase *tcase = tcase_create("AutoreleasePool");
+  tcase_add_test(tcase, _autorelease);
+  tcase_add_test(tcase, nesting);
+  tcase_add_test(tcase, arena);
+  tcase_add_test(tcase, arena_dealloc);
+
+  Suite *suite = suite_create("AutoreleasePool");
+  suite_add_tcase(suite, tcase);
+
+  SRunner *runner = srunner_create(suite);
+
+  srunner_run_all(runner, CK_VERBOSE);
+  int failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return failed;
+}
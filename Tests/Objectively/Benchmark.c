@@ -0,0 +1,846 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <time.h>
+
+#include "Objectively.h"
+
+/**
+ * @file
+ * @brief Microbenchmarks, run on demand rather than by `make check`.
+ */
+
+/**
+ * @return The monotonic time, in nanoseconds.
+ */
+static double now(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Runs `statements` `iterations` times, and reports the mean time of each.
+ */
+#define benchmark(name, iterations, statements) { \
+  const double start = now(); \
+  for (size_t _i = 0; _i < (iterations); _i++) { \
+    statements; \
+  } \
+  printf("%-40s %8.2f ns\n", name, (now() - start) / (iterations)); \
+}
+
+#define ITERATIONS 10000000
+
+/**
+ * @return The peak resident set size of this process, in bytes.
+ */
+static size_t rss(void) {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+  return usage.ru_maxrss;
+#else
+  return usage.ru_maxrss * 1024;
+#endif
+}
+
+/**
+ * @brief The subtype test `_cast` and `Object::isKindOfClass` made before ancestor displays.
+ */
+static bool walk(const Class *c, const Class *clazz) {
+  while (c) {
+    if (c == clazz) {
+      return true;
+    }
+    c = c->def.superclass;
+  }
+  return false;
+}
+
+START_TEST(subclass) {
+
+  URL *url = $(alloc(URL), initWithCharacters, "http://example.com");
+  URLSessionDataTask *task = $($$(URLSession, sharedInstance), dataTaskWithURL, url, NULL);
+
+  const Class *clazz = classof(task);
+  const Class *object = _Object(), *string = _String();
+  volatile bool result;
+
+  benchmark("walk: URLSessionDataTask, Object", ITERATIONS, result = walk(clazz, object));
+  benchmark("issubclassof: URLSessionDataTask, Object", ITERATIONS, result = issubclassof(clazz, object));
+
+  benchmark("walk: URLSessionDataTask, String", ITERATIONS, result = walk(clazz, string));
+  benchmark("issubclassof: URLSessionDataTask, String", ITERATIONS, result = issubclassof(clazz, string));
+
+  benchmark("cast: URLSessionTask", ITERATIONS, cast(URLSessionTask, task));
+  benchmark("instanceof: URLSessionTask", ITERATIONS, result = instanceof(URLSessionTask, task));
+
+  ck_assert(result);
+
+  release(task);
+  release(url);
+
+} END_TEST
+
+#define DICTIONARY_KEYS 100000
+
+START_TEST(dictionary) {
+
+  String *keys[DICTIONARY_KEYS], *misses[DICTIONARY_KEYS];
+
+  for (size_t i = 0; i < DICTIONARY_KEYS; i++) {
+    keys[i] = $(alloc(String), initWithFormat, "key%zu", i);
+    misses[i] = $(alloc(String), initWithFormat, "miss%zu", i);
+  }
+
+  Dictionary *dict = $(alloc(Dictionary), init);
+  volatile ident result;
+
+  benchmark("Dictionary::setObjectForKey", DICTIONARY_KEYS, $(dict, setObjectForKey, keys[_i], keys[_i]));
+
+  benchmark("Dictionary::objectForKey: hit", ITERATIONS, result = $(dict, objectForKey, keys[_i % DICTIONARY_KEYS]));
+  benchmark("Dictionary::objectForKey: miss", ITERATIONS, result = $(dict, objectForKey, misses[_i % DICTIONARY_KEYS]));
+
+  benchmark("Dictionary::removeObjectForKey", DICTIONARY_KEYS, $(dict, removeObjectForKey, keys[_i]));
+
+  ck_assert_int_eq(0, dict->count);
+
+  release(dict);
+
+  for (size_t i = 0; i < DICTIONARY_KEYS; i++) {
+    release(keys[i]);
+    release(misses[i]);
+  }
+
+} END_TEST
+
+#define SET_OBJECTS 1000000
+
+START_TEST(set) {
+
+  Number **numbers = calloc(SET_OBJECTS, sizeof(Number *));
+
+  for (size_t i = 0; i < SET_OBJECTS; i++) {
+    numbers[i] = $$(Number, numberWithValue, i);
+  }
+
+  Set *set = $(alloc(Set), init);
+  volatile bool result;
+
+  benchmark("Set::addObject", SET_OBJECTS, $(set, addObject, numbers[_i]));
+  benchmark("Set::addObject: duplicate", SET_OBJECTS, $(set, addObject, numbers[_i]));
+  benchmark("Set::containsObject", SET_OBJECTS, result = $(set, containsObject, numbers[_i]));
+  benchmark("Set::removeObject", SET_OBJECTS, $(set, removeObject, numbers[_i]));
+
+  ck_assert(result);
+  ck_assert_int_eq(0, set->count);
+
+  release(set);
+
+  for (size_t i = 0; i < SET_OBJECTS; i++) {
+    release(numbers[i]);
+  }
+
+  free(numbers);
+
+} END_TEST
+
+/**
+ * @brief A string hash function, widened to 64 bits.
+ */
+typedef uint64_t (*StringHashFunc)(const char *chars);
+
+/**
+ * @brief The 32-bit hash that tables used before the 64-bit family.
+ */
+static uint64_t hash32(const char *chars) {
+  return (uint32_t) HashForCString(HASH_SEED, chars);
+}
+
+/**
+ * @brief The 64-bit hash.
+ */
+static uint64_t hash64(const char *chars) {
+  return Hash64ForCString(Hash64Seed(), chars);
+}
+
+/**
+ * @brief Adds the keys of every Dictionary in `obj` to the Vector `keys`.
+ */
+static void collectKeys(ident obj, Vector *keys);
+
+/**
+ * @brief DictionaryEnumerator for collectKeys.
+ */
+static void collectKeys_enumerate(const Dictionary *dictionary, ident obj, ident key, ident data) {
+
+  const char *chars = ((String *) key)->chars;
+  $((Vector *) data, add, &chars);
+
+  collectKeys(obj, data);
+}
+
+static void collectKeys(ident obj, Vector *keys) {
+
+  if (instanceof(Dictionary, obj)) {
+    $((Dictionary *) obj, enumerateObjectsAndKeys, collectKeys_enumerate, keys);
+  } else if (instanceof(Array, obj)) {
+    const Array *array = obj;
+    for (size_t i = 0; i < array->count; i++) {
+      collectKeys($(array, objectAtIndex, i), keys);
+    }
+  }
+}
+
+/**
+ * @brief ClassEnumerator for the Class name key set.
+ */
+static void collectClassNames(Class *clazz, ident data) {
+  $((Vector *) data, add, &clazz->def.name);
+}
+
+/**
+ * @brief Reports the collision rate and throughput of `func` over `keys`.
+ * @details The collision rate is the fraction of keys that land in an occupied slot of a table at
+ * half load, indexed by masking the hash, as Dictionary, Set and the Class index are. A uniform
+ * hash scores about 21%.
+ */
+static void hashKeys(const char *name, StringHashFunc func, const Vector *keys) {
+
+  const char **chars = keys->elements;
+
+  size_t capacity = 1;
+  while (capacity < keys->count * 2) {
+    capacity <<= 1;
+  }
+
+  bool *slots = calloc(capacity, sizeof(bool));
+  ck_assert_ptr_ne(NULL, slots);
+
+  size_t collisions = 0;
+  for (size_t i = 0; i < keys->count; i++) {
+    const size_t slot = func(chars[i]) & (capacity - 1);
+    if (slots[slot]) {
+      collisions++;
+    }
+    slots[slot] = true;
+  }
+
+  free(slots);
+
+  char label[64];
+  snprintf(label, sizeof(label), "%s: collisions", name);
+  printf("%-40s %8.2f %%\n", label, collisions * 100.0 / keys->count);
+
+  volatile uint64_t result;
+
+  snprintf(label, sizeof(label), "%s: throughput", name);
+  benchmark(label, ITERATIONS, result = func(chars[_i % keys->count]));
+}
+
+#define HASH_KEYS 100000
+
+START_TEST(hash) {
+
+  Vector *synthetic = $(alloc(Vector), initWithSize, sizeof(char *));
+  Vector *json = $(alloc(Vector), initWithSize, sizeof(char *));
+  Vector *classes = $(alloc(Vector), initWithSize, sizeof(char *));
+
+  String *strings[HASH_KEYS];
+  for (size_t i = 0; i < HASH_KEYS; i++) {
+    strings[i] = $(alloc(String), initWithFormat, "key%zu", i);
+    $(synthetic, add, &strings[i]->chars);
+  }
+
+  Data *data = $$(Data, dataWithContentsOfFile, "Fixtures/test.json");
+  ck_assert(data);
+
+  JSONContext *ctx = $(alloc(JSONContext), init);
+
+  ident document = $(ctx, objectFromData, data, 0);
+  ck_assert(document);
+
+  collectKeys(document, json);
+  enumerateClasses(collectClassNames, classes);
+
+  hashKeys("HashForCString: key%zu", hash32, synthetic);
+  hashKeys("Hash64ForCString: key%zu", hash64, synthetic);
+  hashKeys("HashForCString: JSON keys", hash32, json);
+  hashKeys("Hash64ForCString: JSON keys", hash64, json);
+  hashKeys("HashForCString: Class names", hash32, classes);
+  hashKeys("Hash64ForCString: Class names", hash64, classes);
+
+  release(document);
+  release(ctx);
+  release(data);
+
+  for (size_t i = 0; i < HASH_KEYS; i++) {
+    release(strings[i]);
+  }
+
+  release(synthetic);
+  release(json);
+  release(classes);
+
+} END_TEST
+
+#define JSON_DOCUMENTS 10000
+
+START_TEST(json) {
+
+  Data *data = $$(Data, dataWithContentsOfFile, "Fixtures/test.json");
+  ck_assert(data);
+
+  JSONContext *ctx = $(alloc(JSONContext), init);
+  ident *documents = calloc(JSON_DOCUMENTS, sizeof(ident));
+
+  const size_t before = rss();
+
+  benchmark("JSONContext::objectFromData", JSON_DOCUMENTS, documents[_i] = $(ctx, objectFromData, data, 0));
+
+  printf("%-40s %8zu bytes\n", "JSONContext::objectFromData: RSS", (rss() - before) / JSON_DOCUMENTS);
+
+  for (size_t i = 0; i < JSON_DOCUMENTS; i++) {
+    ck_assert(documents[i]);
+    release(documents[i]);
+  }
+
+  free(documents);
+
+  release(ctx);
+  release(data);
+
+} END_TEST
+
+#define BUILDER_APPENDS 1000000
+
+START_TEST(builder) {
+
+  const char *chars = "0123456789abcdef";
+
+  String *string = $(alloc(String), init);
+  StringBuilder *builder = $(alloc(StringBuilder), init);
+
+  benchmark("String::appendCharacters", BUILDER_APPENDS, $(string, appendCharacters, chars));
+  benchmark("StringBuilder::appendCharacters", BUILDER_APPENDS, $(builder, appendCharacters, chars));
+  benchmark("StringBuilder::string", 1, release($(builder, string)));
+
+  ck_assert_int_eq(string->length, builder->length);
+
+  release(builder);
+  release(string);
+
+  Array *array = $(alloc(Array), init);
+  for (size_t i = 0; i < BUILDER_APPENDS / 10; i++) {
+    Number *number = $$(Number, numberWithValue, i);
+    $(array, addObject, number);
+    release(number);
+  }
+
+  benchmark("Array::description: 10^5 Numbers", 10, release($((Object *) array, description)));
+
+  release(array);
+
+} END_TEST
+
+#define ENCODING_ITERATIONS 100000
+
+START_TEST(encoding) {
+
+  String *ascii = str("The quick brown fox jumps over the lazy dog, %d times over.", 42);
+  String *latin1 = str("Ça va? Déjà vu, à la carte, über naïve façade.");
+
+  benchmark("String::lowercaseString: ASCII", ENCODING_ITERATIONS, release($(ascii, lowercaseString)));
+  benchmark("String::uppercaseString: ASCII", ENCODING_ITERATIONS, release($(ascii, uppercaseString)));
+  benchmark("String::uppercaseString: Latin-1", ENCODING_ITERATIONS, release($(latin1, uppercaseString)));
+
+  benchmark("String::getData: UTF-16", ENCODING_ITERATIONS, release($(latin1, getData, STRING_ENCODING_UTF16)));
+  benchmark("String::getData: Latin-2", ENCODING_ITERATIONS, release($(ascii, getData, STRING_ENCODING_LATIN2)));
+
+  Data *data = $(latin1, getData, STRING_ENCODING_UTF16);
+  benchmark("String::stringWithData: UTF-16", ENCODING_ITERATIONS, release($$(String, stringWithData, data, STRING_ENCODING_UTF16)));
+
+  release(data);
+  release(latin1);
+  release(ascii);
+
+} END_TEST
+
+/**
+ * @brief The search `String::rangeOfCharacters` made before it was vectorized.
+ */
+static Range strncmpRangeOfCharacters(const String *string, const char *chars, const Range range) {
+  const size_t len = strlen(chars);
+  const char *str = string->chars + range.location;
+  for (size_t i = 0; i < range.length; i++, str++) {
+    if (strncmp(str, chars, len) == 0) {
+      return (Range) { range.location + i, len };
+    }
+  }
+  return (Range) { -1, 0 };
+}
+
+/**
+ * @brief The replacement `String::replaceOccurrencesOfCharacters` made before it was single-pass.
+ */
+static void eachReplaceOccurrencesOfCharacters(String *string, const char *chars, const char *replacement) {
+  Range search = { 0, string->length };
+  while (search.length > 0) {
+    const Range result = strncmpRangeOfCharacters(string, chars, search);
+    if (result.location == -1) {
+      break;
+    }
+    $(string, replaceCharactersInRange, result, replacement);
+    search.length -= (result.location - search.location) + strlen(chars);
+    search.location = result.location + strlen(replacement);
+  }
+}
+
+/**
+ * @return A template of `length` bytes, with a `{{name}}` placeholder every `interval` bytes.
+ */
+static String *template(size_t length, size_t interval) {
+  String *string = $(alloc(String), initWithCapacity, length);
+  while (string->length + interval <= length) {
+    for (size_t i = 0; i < interval - 8; i += 8) {
+      $(string, appendCharacters, i % 64 ? "lorem { " : "ipsum {{");
+    }
+    $(string, appendCharacters, "{{name}}");
+  }
+  return string;
+}
+
+START_TEST(search) {
+
+  const size_t sizes[] = { 4 * 1024, 1024 * 1024 };
+  const char *names[] = { "4 KiB", "1 MiB" };
+
+  for (size_t i = 0; i < lengthof(sizes); i++) {
+
+    String *string = template(sizes[i], sizes[i]);
+    const Range range = { 0, string->length };
+
+    const size_t iterations = (1 << 24) / sizes[i];
+    Range match = { -1, 0 };
+    char name[64];
+
+    snprintf(name, sizeof(name), "strncmp search: %s", names[i]);
+    benchmark(name, iterations, match = strncmpRangeOfCharacters(string, "{{name}}", range));
+    ck_assert_int_eq(string->length - 8, match.location);
+
+    snprintf(name, sizeof(name), "String::rangeOfCharacters: %s", names[i]);
+    benchmark(name, iterations, match = $(string, rangeOfCharacters, "{{name}}", range));
+    ck_assert_int_eq(string->length - 8, match.location);
+
+    release(string);
+
+    String *before = template(sizes[i], 1024);
+    String *after = template(sizes[i], 1024);
+
+    snprintf(name, sizeof(name), "per-match replace: %s", names[i]);
+    benchmark(name, 1, eachReplaceOccurrencesOfCharacters(before, "{{name}}", "Objectively"));
+
+    snprintf(name, sizeof(name), "String::replaceOccurrences: %s", names[i]);
+    benchmark(name, 1, $(after, replaceOccurrencesOfCharacters, "{{name}}", "Objectively"));
+
+    ck_assert_str_eq(before->chars, after->chars);
+
+    release(before);
+    release(after);
+  }
+
+} END_TEST
+
+START_TEST(growth) {
+
+  Object *object = $(alloc(Object), init);
+
+  ident *objects = malloc(1000000 * sizeof(ident));
+  for (size_t i = 0; i < 1000000; i++) {
+    objects[i] = object;
+  }
+
+  for (size_t count = 10000; count <= 1000000; count *= 10) {
+
+    char name[64];
+
+    Array *array = $$(Array, array);
+    snprintf(name, sizeof(name), "Array::addObject: %zu", count);
+    benchmark(name, count, $(array, addObject, object));
+    release(array);
+
+    array = $$(Array, array);
+    snprintf(name, sizeof(name), "Array::addObjectsWithCount: %zu, total", count);
+    benchmark(name, 1, $(array, addObjectsWithCount, count, objects));
+    release(array);
+
+    Vector *vector = $$(Vector, vectorWithSize, sizeof(size_t));
+    snprintf(name, sizeof(name), "Vector::add: %zu", count);
+    benchmark(name, count, $(vector, add, &_i));
+    release(vector);
+
+    PointerArray *pointers = $(alloc(PointerArray), init);
+    snprintf(name, sizeof(name), "PointerArray::add: %zu", count);
+    benchmark(name, count, $(pointers, add, object));
+    release(pointers);
+  }
+
+  free(objects);
+  release(object);
+
+} END_TEST
+
+static bool everyOther(const ident obj, ident data) {
+  return (*(size_t *) data)++ % 2;
+}
+
+/**
+ * @brief The previous Array::filter, which removed rejected elements one at a time.
+ */
+static void eachRemoveObjectAtIndex(Array *array, Predicate predicate, ident data) {
+  for (size_t i = 0; i < array->count; i++) {
+    if (predicate(array->elements[i], data) == false) {
+      $(array, removeObjectAtIndex, i--);
+    }
+  }
+}
+
+START_TEST(removal) {
+
+  Object *object = $(alloc(Object), init);
+
+  for (size_t count = 10000; count <= 100000; count *= 10) {
+
+    char name[64];
+    size_t n;
+
+    ident *objects = malloc(count * sizeof(ident));
+    for (size_t i = 0; i < count; i++) {
+      objects[i] = object;
+    }
+
+    Array *array = $$(Array, array);
+    $(array, addObjectsWithCount, count, objects);
+    snprintf(name, sizeof(name), "removeObjectAtIndex: filter %zu, total", count);
+    n = 0; benchmark(name, 1, eachRemoveObjectAtIndex(array, everyOther, &n));
+    release(array);
+
+    array = $$(Array, array);
+    $(array, addObjectsWithCount, count, objects);
+    snprintf(name, sizeof(name), "Array::filter: %zu, total", count);
+    n = 0; benchmark(name, 1, $(array, filter, everyOther, &n));
+    release(array);
+
+    array = $$(Array, array);
+    $(array, addObjectsWithCount, count, objects);
+    snprintf(name, sizeof(name), "Array::partition: %zu, total", count);
+    n = 0; benchmark(name, 1, $(array, partition, everyOther, &n));
+    release(array);
+
+    free(objects);
+  }
+
+  release(object);
+
+} END_TEST
+
+static Order compareInts(const ident a, const ident b) {
+  return *(int *) a - *(int *) b;
+}
+
+static Order compareNumbers(const ident a, const ident b) {
+  return $((Number *) a, compareTo, (Number *) b);
+}
+
+/**
+ * @brief The previous List::sort, an insertion sort which moved elements between nodes.
+ */
+static void insertionSort(List *list, Comparator comparator) {
+  for (ListNode *node = list->head->next; node; ) {
+    ListNode *next = node->next;
+    ident key = node->element;
+
+    ListNode *j = node->prev;
+    while (j && comparator(j->element, key) > OrderSame) {
+      j->next->element = j->element;
+      j = j->prev;
+    }
+
+    (j ? j->next : list->head)->element = key;
+    node = next;
+  }
+}
+
+START_TEST(sorting) {
+
+  int *ints = malloc(1000000 * sizeof(int));
+  for (size_t i = 0; i < 1000000; i++) {
+    ints[i] = rand();
+  }
+
+  for (size_t count = 10000; count <= 1000000; count *= 10) {
+
+    char name[64];
+
+    List *list = $(alloc(List), init);
+    for (size_t i = 0; i < count; i++) {
+      $(list, append, ints + i);
+    }
+
+    if (count <= 10000) {
+      snprintf(name, sizeof(name), "insertion sort: List %zu, total", count);
+      benchmark(name, 1, insertionSort(list, compareInts));
+      release(list);
+
+      list = $(alloc(List), init);
+      for (size_t i = 0; i < count; i++) {
+        $(list, append, ints + i);
+      }
+    }
+
+    snprintf(name, sizeof(name), "List::sort: %zu, total", count);
+    benchmark(name, 1, $(list, sort, compareInts));
+    release(list);
+  }
+
+  OperationQueue *queue = $(alloc(OperationQueue), initWithMaxConcurrentOperations, 4);
+
+  Array *array = $$(Array, array);
+  for (size_t i = 0; i < 1000000; i++) {
+    Number *number = $$(Number, numberWithValue, ints[i]);
+    $(array, addObject, number);
+    release(number);
+  }
+
+  Array *copy = (Array *) $((Object *) array, copy);
+  benchmark("Array::sort: 10^6, total", 1, $(copy, sort, compareNumbers));
+  release(copy);
+
+  copy = (Array *) $((Object *) array, copy);
+  benchmark("Array::stableSort: 10^6, total", 1, $(copy, stableSort, compareNumbers));
+  release(copy);
+
+  copy = (Array *) $((Object *) array, copy);
+  benchmark("Array::parallelSort: 10^6, 4 threads, total", 1, $(copy, parallelSort, compareNumbers, queue));
+  release(copy);
+
+  release(array);
+  release(queue);
+
+  free(ints);
+
+} END_TEST
+
+static ident square(const ident obj, ident data) {
+  const double value = $((Number *) obj, doubleValue);
+  return $$(Number, numberWithValue, value * value);
+}
+
+static ident sum(const ident obj, ident accumulator, ident data) {
+  return (ident) ((intptr_t) accumulator + $((Number *) obj, intValue));
+}
+
+static ident combine(const ident obj, ident accumulator, ident data) {
+  return (ident) ((intptr_t) accumulator + (intptr_t) obj);
+}
+
+START_TEST(parallel) {
+
+  Array *array = $$(Array, array);
+  for (size_t i = 0; i < 1000000; i++) {
+    Number *number = $$(Number, numberWithValue, i);
+    $(array, addObject, number);
+    release(number);
+  }
+
+  ident result;
+
+  benchmark("Array::mappedArray: 10^6, total", 1, release($(array, mappedArray, square, NULL)));
+  benchmark("Array::parallelMappedArray: 10^6, total", 1, release($(array, parallelMappedArray, square, NULL, NULL)));
+
+  benchmark("Array::reduce: 10^6, total", 1, result = $(array, reduce, sum, NULL, NULL));
+  benchmark("Array::parallelReduce: 10^6, total", 1, result = $(array, parallelReduce, sum, combine, NULL, NULL, NULL));
+
+  ck_assert_ptr_ne(NULL, result);
+
+  release(array);
+
+} END_TEST
+
+/**
+ * @brief The previous HashTable, which chained a separately allocated node per entry.
+ */
+typedef struct ChainedEntry {
+  ident key, value;
+  struct ChainedEntry *next;
+} ChainedEntry;
+
+typedef struct {
+  size_t count, capacity;
+  ChainedEntry **buckets;
+} ChainedTable;
+
+static ChainedEntry **chainedBucket(const ChainedTable *table, const ident key) {
+  return &table->buckets[HashTableHashStr(key) % table->capacity];
+}
+
+static ident chainedGet(const ChainedTable *table, const ident key) {
+  for (const ChainedEntry *e = *chainedBucket(table, key); e; e = e->next) {
+    if (HashTableEqualStr(e->key, key)) {
+      return e->value;
+    }
+  }
+  return NULL;
+}
+
+static void chainedSet(ChainedTable *table, const ident key, const ident value) {
+
+  if ((float) table->count / (float) table->capacity >= 0.75f) {
+    const size_t capacity = table->capacity * 2;
+    ChainedEntry **buckets = calloc(capacity, sizeof(ChainedEntry *));
+    for (size_t i = 0; i < table->capacity; i++) {
+      for (ChainedEntry *e = table->buckets[i]; e; ) {
+        ChainedEntry *next = e->next;
+        const size_t bin = HashTableHashStr(e->key) % capacity;
+        e->next = buckets[bin];
+        buckets[bin] = e;
+        e = next;
+      }
+    }
+    free(table->buckets);
+    table->buckets = buckets;
+    table->capacity = capacity;
+  }
+
+  ChainedEntry **bucket = chainedBucket(table, key);
+  for (ChainedEntry *e = *bucket; e; e = e->next) {
+    if (HashTableEqualStr(e->key, key)) {
+      e->value = value;
+      return;
+    }
+  }
+
+  ChainedEntry *e = calloc(1, sizeof(ChainedEntry));
+  e->key = key;
+  e->value = value;
+  e->next = *bucket;
+  *bucket = e;
+  table->count++;
+}
+
+static void chainedRemove(ChainedTable *table, const ident key) {
+  for (ChainedEntry **e = chainedBucket(table, key); *e; e = &(*e)->next) {
+    if (HashTableEqualStr((*e)->key, key)) {
+      ChainedEntry *found = *e;
+      *e = found->next;
+      free(found);
+      table->count--;
+      return;
+    }
+  }
+}
+
+#define HASHTABLE_KEYS 1000000
+
+START_TEST(hashTable) {
+
+  char (*keys)[16] = malloc(HASHTABLE_KEYS * sizeof(*keys));
+  char (*misses)[16] = malloc(HASHTABLE_KEYS * sizeof(*misses));
+
+  for (size_t i = 0; i < HASHTABLE_KEYS; i++) {
+    snprintf(keys[i], sizeof(*keys), "key%zu", i);
+    snprintf(misses[i], sizeof(*misses), "miss%zu", i);
+  }
+
+  ChainedTable chained = { .capacity = 16, .buckets = calloc(16, sizeof(ChainedEntry *)) };
+  HashTable *table = $(alloc(HashTable), init, HashTableHashStr, HashTableEqualStr);
+
+  ident result;
+
+  benchmark("chained: set", HASHTABLE_KEYS, chainedSet(&chained, keys[_i], keys[_i]));
+  benchmark("HashTable::set", HASHTABLE_KEYS, $(table, set, keys[_i], keys[_i]));
+
+  benchmark("chained: get, hit", HASHTABLE_KEYS, result = chainedGet(&chained, keys[(_i * 7919) % HASHTABLE_KEYS]));
+  benchmark("HashTable::get: hit", HASHTABLE_KEYS, result = $(table, get, keys[(_i * 7919) % HASHTABLE_KEYS]));
+
+  benchmark("chained: get, miss", HASHTABLE_KEYS, result = chainedGet(&chained, misses[(_i * 7919) % HASHTABLE_KEYS]));
+  benchmark("HashTable::get: miss", HASHTABLE_KEYS, result = $(table, get, misses[(_i * 7919) % HASHTABLE_KEYS]));
+
+  benchmark("chained: remove, set", HASHTABLE_KEYS, {
+    chainedRemove(&chained, keys[(_i * 7919) % HASHTABLE_KEYS]);
+    chainedSet(&chained, misses[_i], misses[_i]);
+  });
+  benchmark("HashTable::remove, set", HASHTABLE_KEYS, {
+    $(table, remove, keys[(_i * 7919) % HASHTABLE_KEYS]);
+    $(table, set, misses[_i], misses[_i]);
+  });
+
+  benchmark("chained: remove", HASHTABLE_KEYS, chainedRemove(&chained, misses[_i]));
+  benchmark("HashTable::remove", HASHTABLE_KEYS, $(table, remove, misses[_i]));
+
+  ck_assert_int_eq(0, chained.count);
+  ck_assert_int_eq(0, table->count);
+  (void) result;
+
+  free(chained.buckets);
+  release(table);
+
+  free(keys);
+  free(misses);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+  TCase *tcase = tcase_create("Benchmark");
+  tcase_set_timeout(tcase, 600);
+  tcase_add_test(tcase, subclass);
+  tcase_add_test(tcase, dictionary);
+  tcase_add_test(tcase, set);
+  tcase_add_test(tcase, hash);
+  tcase_add_test(tcase, json);
+  tcase_add_test(tcase, builder);
+  tcase_add_test(tcase, encoding);
+  tcase_add_test(tcase, search);
+  tcase_add_test(tcase, growth);
+  tcase_add_test(tcase, removal);
+  tcase_add_test(tcase, sorting);
+  tcase_add_test(tcase, parallel);
+  tcase_add_test(tcase, hashTable);
+
+  Suite *suite = suite_create("Benchmark");
+  suite_add_tcase(suite, tcase);
+
+  SRunner *runner = srunner_create(suite);
+
+  srunner_run_all(runner, CK_VERBOSE);
+  int failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return failed;
+}
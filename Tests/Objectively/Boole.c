@@ -32,6 +32,15 @@ START_TEST(boole) {
   Boole *False = $$(Boole, False);
   ck_assert(False->value == false);
 
+  for (int i = 0; i < 10; i++) {
+    release(True);
+    release(False);
+  }
+
+  ck_assert(retain(True) == True);
+  ck_assert_int_eq(1, ((Object *) True)->referenceCount);
+  ck_assert(True->value == true);
+
 } END_TEST
 
 int main(int argc, char **argv) {
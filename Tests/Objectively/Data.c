@@ -90,6 +90,59 @@ START_TEST(data_mutation) {
 
 } END_TEST
 
+START_TEST(data_capacity) {
+
+  Data *data = $(alloc(Data), init);
+
+  for (int i = 0; i < 1000; i++) {
+    $(data, appendBytes, (uint8_t *) "x", 1);
+  }
+
+  ck_assert_int_eq(1000, data->length);
+  ck_assert_int_lt(data->capacity, 2000);
+
+  $(data, shrinkToFit);
+
+  ck_assert_int_eq(1000, data->capacity);
+  ck_assert_int_eq('x', data->bytes[999]);
+
+  release(data);
+
+  const uint8_t bytes[] = "const";
+
+  data = $(alloc(Data), initWithConstMemory, (ident) bytes, 5);
+
+  $(data, shrinkToFit);
+
+  ck_assert_ptr_eq(bytes, data->bytes);
+
+  release(data);
+
+} END_TEST
+
+START_TEST(data_hash) {
+
+  Data *data = $(alloc(Data), initWithBytes, (uint8_t *) "abc", 3);
+  Data *other = $(alloc(Data), initWithBytes, (uint8_t *) "abcdef", 6);
+
+  const int hash = $((Object *) data, hash);
+
+  ck_assert_int_eq(hash, data->hash);
+
+  $(data, appendBytes, (uint8_t *) "def", 3);
+
+  ck_assert_int_eq(0, data->hash);
+  ck_assert_int_eq($((Object *) other, hash), $((Object *) data, hash));
+
+  $(data, setLength, 3);
+
+  ck_assert_int_eq(hash, $((Object *) data, hash));
+
+  release(data);
+  release(other);
+
+} END_TEST
+
 
 int main(int argc, char **argv) {
 
@@ -97,6 +150,8 @@ int main(int argc, char **argv) {
   tcase_add_test(tcase, data);
 
   tcase_add_test(tcase, data_mutation);
+  tcase_add_test(tcase, data_capacity);
+  tcase_add_test(tcase, data_hash);
 
   Suite *suite = suite_create("Data");
   suite_add_tcase(suite, tcase);
@@ -171,11 +171,151 @@ START_TEST(dictionary_mutation) {
 
 } END_TEST
 
+START_TEST(dictionary_copy) {
+
+  Object *obj = $(alloc(Object), init);
+  String *key = $$(String, stringWithCharacters, "key");
+
+  Dictionary *dict = $$(Dictionary, dictionaryWithObjectsAndKeys, obj, key, NULL);
+  Dictionary *copy = (Dictionary *) $((Object *) dict, copy);
+
+  ck_assert_ptr_eq(dict->elements, copy->elements);
+  ck_assert_int_eq(2, obj->referenceCount);
+
+  $(copy, removeObjectForKey, key);
+
+  ck_assert_ptr_ne(dict->elements, copy->elements);
+  ck_assert_ptr_eq(obj, $(dict, objectForKey, key));
+  ck_assert_ptr_eq(NULL, $(copy, objectForKey, key));
+  ck_assert_int_eq(1, dict->count);
+  ck_assert_int_eq(0, copy->count);
+  ck_assert_int_eq(2, obj->referenceCount);
+
+  release(copy);
+
+  copy = (Dictionary *) $((Object *) dict, copy);
+
+  $(dict, removeAllObjects);
+
+  ck_assert_int_eq(0, dict->count);
+  ck_assert_ptr_eq(obj, $(copy, objectForKey, key));
+  ck_assert_int_eq(2, obj->referenceCount);
+
+  release(dict);
+  release(copy);
+
+  ck_assert_int_eq(1, obj->referenceCount);
+
+  release(obj);
+  release(key);
+
+} END_TEST
+
+START_TEST(dictionary_probing) {
+
+  Dictionary *dict = $$(Dictionary, dictionaryWithCapacity, 3);
+
+  ck_assert_int_eq(4, dict->capacity);
+
+  for (int i = 0; i < 4096; i++) {
+
+    Number *key = $$(Number, numberWithValue, i);
+    String *obj = $(alloc(String), initWithFormat, "%d", i);
+
+    $(dict, setObjectForKey, obj, key);
+
+    release(key);
+    release(obj);
+  }
+
+  ck_assert_int_eq(4096, dict->count);
+  ck_assert_int_eq(0, dict->capacity & (dict->capacity - 1));
+
+  for (int i = 0; i < 4096; i += 2) {
+
+    Number *key = $$(Number, numberWithValue, i);
+
+    $(dict, removeObjectForKey, key);
+
+    release(key);
+  }
+
+  ck_assert_int_eq(2048, dict->count);
+
+  for (int i = 0; i < 4096; i++) {
+
+    Number *key = $$(Number, numberWithValue, i);
+    String *obj = $(dict, objectForKey, key);
+
+    if (i & 1) {
+      ck_assert_int_eq(i, atoi(obj->chars));
+    } else {
+      ck_assert_ptr_eq(NULL, obj);
+    }
+
+    release(key);
+  }
+
+  release(dict);
+
+} END_TEST
+
+START_TEST(dictionary_keyPath) {
+
+  Dictionary *dict = $(alloc(Dictionary), init);
+
+  String *key = str("one");
+  Number *one = $$(Number, numberWithValue, 1);
+  Number *two = $$(Number, numberWithValue, 2);
+
+  $(dict, setObjectForKey, one, key);
+
+  ck_assert_ptr_eq(one, $(dict, objectForKeyPath, "one"));
+  ck_assert_ptr_eq(one, $(dict, objectForKeyWithCharacters, "one two", 3));
+  ck_assert_ptr_eq(NULL, $(dict, objectForKeyWithCharacters, "one two", 4));
+  ck_assert_ptr_eq(NULL, $(dict, objectForKeyPath, "two"));
+
+  $(dict, setObjectForKeyPath, two, "one");
+
+  ck_assert_int_eq(1, dict->count);
+  ck_assert_ptr_eq(two, $(dict, objectForKey, key));
+
+  $(dict, setObjectForKeyPath, one, "two");
+
+  ck_assert_int_eq(2, dict->count);
+  ck_assert_ptr_eq(one, $(dict, objectForKeyPath, "two"));
+
+  String *other = str("two");
+  ck_assert_ptr_eq(one, $(dict, objectForKey, other));
+  release(other);
+
+  Number *three = $$(Number, numberWithValue, 3);
+  $(dict, setObjectForKey, key, three);
+
+  ck_assert_ptr_eq(NULL, $(dict, objectForKeyPath, "3"));
+
+  $(dict, removeObjectForKeyPath, "one");
+  $(dict, removeObjectForKeyPath, "two");
+
+  ck_assert_int_eq(1, dict->count);
+  ck_assert_ptr_eq(key, $(dict, objectForKey, three));
+
+  release(three);
+  release(two);
+  release(one);
+  release(key);
+  release(dict);
+
+} END_TEST
+
 
 int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("Dictionary");
   tcase_add_test(tcase, dictionary);
+  tcase_add_test(tcase, dictionary_copy);
+  tcase_add_test(tcase, dictionary_probing);
+  tcase_add_test(tcase, dictionary_keyPath);
 
   tcase_add_test(tcase, dictionary_mutation);
 
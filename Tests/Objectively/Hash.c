@@ -0,0 +1,147 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Objectively.h"
+
+START_TEST(hash64ForBytes) {
+
+  uint8_t bytes[128], unaligned[129];
+  for (size_t i = 0; i < sizeof(bytes); i++) {
+    bytes[i] = (uint8_t) (i * 7 + 1);
+  }
+
+  memcpy(unaligned + 1, bytes, sizeof(bytes));
+
+  for (size_t length = 0; length <= sizeof(bytes); length++) {
+
+    const uint64_t hash = Hash64ForBytes(1, bytes, length);
+
+    ck_assert(hash == Hash64ForBytes(1, unaligned + 1, length));
+    ck_assert(hash != Hash64ForBytes(2, bytes, length));
+
+    if (length) {
+      ck_assert(hash != Hash64ForBytes(1, bytes, length - 1));
+
+      bytes[length - 1] ^= 1;
+      ck_assert(hash != Hash64ForBytes(1, bytes, length));
+      bytes[length - 1] ^= 1;
+    }
+  }
+
+  ck_assert(Hash64ForCString(1, "key") == Hash64ForBytes(1, "key", 3));
+
+} END_TEST
+
+START_TEST(hash64Seed) {
+
+  ck_assert(Hash64Seed() == Hash64Seed());
+
+  ck_assert(Hash64ForInteger(Hash64Seed(), 1) != Hash64ForInteger(Hash64Seed(), 2));
+  ck_assert(Hash64Combine(1, 2) != Hash64Combine(2, 1));
+
+} END_TEST
+
+START_TEST(hash64Collisions) {
+
+  const size_t count = 1 << 16, mask = (count << 1) - 1;
+
+  uint8_t *buckets = calloc(mask + 1, sizeof(uint8_t));
+  ck_assert_ptr_ne(NULL, buckets);
+
+  size_t collisions = 0;
+  for (size_t i = 0; i < count; i++) {
+
+    char key[32];
+    const int length = snprintf(key, sizeof(key), "key%zu", i);
+
+    const uint64_t hash = Hash64ForBytes(Hash64Seed(), key, length);
+    if (buckets[hash & mask]++) {
+      collisions++;
+    }
+  }
+
+  // At half load, a uniform hash collides on about a fifth of its keys
+  ck_assert(collisions < count / 4);
+
+  free(buckets);
+
+} END_TEST
+
+START_TEST(containers) {
+
+  Number *zero = $$(Number, numberWithValue, 0.0);
+  Number *negativeZero = $$(Number, numberWithValue, -0.0);
+
+  ck_assert($((Object *) zero, isEqual, (Object *) negativeZero));
+  ck_assert_int_eq($((Object *) zero, hash), $((Object *) negativeZero, hash));
+
+  release(zero);
+  release(negativeZero);
+
+  Dictionary *a = $(alloc(Dictionary), init);
+  Dictionary *b = $(alloc(Dictionary), init);
+
+  for (int i = 0; i < 100; i++) {
+    Number *number = $$(Number, numberWithValue, i);
+    $(a, setObjectForKey, number, number);
+    release(number);
+  }
+
+  for (int i = 99; i >= 0; i--) {
+    Number *number = $$(Number, numberWithValue, i);
+    $(b, setObjectForKey, number, number);
+    release(number);
+  }
+
+  ck_assert($((Object *) a, isEqual, (Object *) b));
+  ck_assert_int_eq($((Object *) a, hash), $((Object *) b, hash));
+
+  release(a);
+  release(b);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+  TCase *tcase = tcase_create("Hash");
+  tcase_add_test(tcase, hash64ForBytes);
+  tcase_add_test(tcase, hash64Seed);
+  tcase_add_test(tcase, hash64Collisions);
+  tcase_add_test(tcase, containers);
+
+  Suite *suite = suite_create("Hash");
+  suite_add_tcase(suite, tcase);
+
+  SRunner *runner = srunner_create(suite);
+
+  srunner_run_all(runner, CK_VERBOSE);
+  int failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return failed;
+}
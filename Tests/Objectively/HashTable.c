@@ -199,6 +199,111 @@ START_TEST(hash_direct) {
 
 } END_TEST
 
+static size_t constantHash(const ident key) {
+  return 42;
+}
+
+START_TEST(collisions) {
+
+  HashTable *table = $(alloc(HashTable), init, constantHash, HashTableEqualDirect);
+
+  intptr_t keys[100];
+  for (size_t i = 0; i < lengthof(keys); i++) {
+    keys[i] = i + 1;
+    $(table, set, (ident) keys[i], (ident) keys[i]);
+  }
+
+  ck_assert_int_eq(lengthof(keys), table->count);
+
+  for (size_t i = 0; i < lengthof(keys); i += 2) {
+    $(table, remove, (ident) keys[i]);
+  }
+
+  ck_assert_int_eq(lengthof(keys) / 2, table->count);
+
+  for (size_t i = 0; i < lengthof(keys); i++) {
+    if (i % 2) {
+      ck_assert_ptr_eq((ident) keys[i], $(table, get, (ident) keys[i]));
+    } else {
+      ck_assert(!$(table, containsKey, (ident) keys[i]));
+    }
+  }
+
+  release(table);
+
+} END_TEST
+
+START_TEST(churn) {
+
+  HashTable *table = $(alloc(HashTable), init, HashTableHashDirect, HashTableEqualDirect);
+
+  enum { N = 1000, ROUNDS = 100 };
+  bool present[N] = { false };
+  size_t count = 0;
+
+  srand(0);
+
+  for (int i = 0; i < N * ROUNDS; i++) {
+    const intptr_t key = rand() % N;
+    if (present[key]) {
+      $(table, remove, (ident) (key + 1));
+      present[key] = false;
+      count--;
+    } else {
+      $(table, set, (ident) (key + 1), (ident) (key + 2));
+      present[key] = true;
+      count++;
+    }
+    ck_assert_int_eq(count, table->count);
+  }
+
+  ck_assert_int_le(table->capacity, 4 * N);
+
+  for (intptr_t key = 0; key < N; key++) {
+    ck_assert_int_eq(present[key], $(table, containsKey, (ident) (key + 1)));
+    if (present[key]) {
+      ck_assert_int_eq(key + 2, (intptr_t) $(table, get, (ident) (key + 1)));
+    }
+  }
+
+  int enumerated = 0;
+  $(table, enumerate, enumerator, &enumerated);
+  ck_assert_int_eq(count, enumerated);
+
+  release(table);
+
+} END_TEST
+
+static int destroyed;
+
+static void destroy(ident obj) {
+  destroyed++;
+}
+
+START_TEST(destructors) {
+
+  HashTable *table = $(alloc(HashTable), init, HashTableHashStr, HashTableEqualStr);
+  table->destroyKey = destroy;
+  table->destroyValue = destroy;
+
+  destroyed = 0;
+
+  $(table, set, "one", "1");
+  $(table, set, "two", "2");
+  $(table, set, "one", "uno");
+  ck_assert_int_eq(2, destroyed);
+
+  $(table, remove, "two");
+  ck_assert_int_eq(4, destroyed);
+
+  $(table, remove, "three");
+  ck_assert_int_eq(4, destroyed);
+
+  release(table);
+  ck_assert_int_eq(6, destroyed);
+
+} END_TEST
+
 int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("HashTable");
@@ -212,6 +317,9 @@ int main(int argc, char **argv) {
   tcase_add_test(tcase, set_replaces);
   tcase_add_test(tcase, set_resizes);
   tcase_add_test(tcase, hash_direct);
+  tcase_add_test(tcase, collisions);
+  tcase_add_test(tcase, churn);
+  tcase_add_test(tcase, destructors);
 
   Suite *suite = suite_create("HashTable");
   suite_add_tcase(suite, tcase);
@@ -0,0 +1,138 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Objectively.h"
+
+START_TEST(stats) {
+
+  const ClassStats before = InstrumentationGetStats(_Date());
+
+  Date *dates[1000];
+  for (size_t i = 0; i < lengthof(dates); i++) {
+    dates[i] = $(alloc(Date), init);
+  }
+
+  ClassStats stats = InstrumentationGetStats(_Date());
+  ck_assert_ptr_eq(_Date(), stats.clazz);
+  ck_assert_int_eq(before.liveInstances + 1000, stats.liveInstances);
+  ck_assert_int_eq(stats.liveInstances * sizeof(Date), stats.liveBytes);
+  ck_assert_int_eq(before.totalAllocations + 1000, stats.totalAllocations);
+  ck_assert_int_ge(stats.highWaterMark, stats.liveInstances);
+
+  for (size_t i = 0; i < lengthof(dates); i++) {
+    release(dates[i]);
+  }
+
+  stats = InstrumentationGetStats(_Date());
+  ck_assert_int_eq(before.liveInstances, stats.liveInstances);
+  ck_assert_int_eq(before.totalAllocations + 1000, stats.totalAllocations);
+  ck_assert_int_ge(stats.highWaterMark, before.liveInstances + 1000 - INSTRUMENTATION_BATCH);
+
+} END_TEST
+
+static ident allocate(Thread *thread) {
+
+  for (int i = 0; i < 10000; i++) {
+    release($(alloc(Lock), init));
+  }
+
+  return NULL;
+}
+
+START_TEST(threads) {
+
+  const ClassStats before = InstrumentationGetStats(_Lock());
+
+  Thread *threads[4];
+  for (size_t i = 0; i < lengthof(threads); i++) {
+    threads[i] = $(alloc(Thread), initWithFunction, allocate, NULL);
+    $(threads[i], start);
+  }
+
+  for (size_t i = 0; i < lengthof(threads); i++) {
+    $(threads[i], join, NULL);
+    release(threads[i]);
+  }
+
+  const ClassStats stats = InstrumentationGetStats(_Lock());
+  ck_assert_int_eq(before.liveInstances, stats.liveInstances);
+  ck_assert_int_eq(before.totalAllocations + 40000, stats.totalAllocations);
+
+} END_TEST
+
+static void enumerator(const ClassStats *stats, ident data) {
+
+  if (stats->clazz == _Object()) {
+    *(bool *) data = true;
+  }
+}
+
+START_TEST(enumerate) {
+
+  bool found = false;
+  InstrumentationEnumerate(enumerator, &found);
+  ck_assert(found);
+
+  FILE *file = tmpfile();
+  ck_assert(file != NULL);
+
+  InstrumentationDump(fileno(file));
+  rewind(file);
+
+  char buffer[0x10000];
+  const size_t len = fread(buffer, 1, sizeof(buffer) - 1, file);
+  buffer[len] = '\0';
+
+  fclose(file);
+
+  ck_assert(buffer[0] == '[');
+  char object[64];
+  snprintf(object, sizeof(object), "{\"name\": \"Object\", \"instanceSize\": %zu, ", sizeof(Object));
+  ck_assert(strstr(buffer, object) != NULL);
+  ck_assert(strstr(buffer, "\n]\n") != NULL);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+  TCase *tcase = tcase_create("Instrumentation");
+  tcase_add_test(tcase, stats);
+  tcase_add_test(tcase, threads);
+  tcase_add_test(tcase, enumerate);
+
+  Suite *suite = suite_create("Instrumentation");
+  suite_add_tcase(suite, tcase);
+
+  SRunner *runner = srunner_create(suite);
+
+  srunner_run_all(runner, CK_VERBOSE);
+  int failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return failed;
+}
@@ -417,6 +417,35 @@ START_TEST(sort) {
 
   release(list);
 
+  int keys[1000];
+  list = $(alloc(List), init);
+
+  for (size_t i = 0; i < lengthof(keys); i++) {
+    keys[i] = (i * 7919) % 100;
+    $(list, append, keys + i);
+  }
+
+  $(list, sort, comparator);
+
+  ck_assert_int_eq(lengthof(keys), list->count);
+  ck_assert_ptr_eq(NULL, list->head->prev);
+  ck_assert_ptr_eq(NULL, list->tail->next);
+
+  size_t count = 1;
+  for (const ListNode *node = list->head->next; node; node = node->next, count++) {
+    ck_assert_ptr_eq(node, node->prev->next);
+
+    const int *a = node->prev->element, *b = node->element;
+    ck_assert_int_le(*a, *b);
+    if (*a == *b) {
+      ck_assert(a < b);
+    }
+  }
+
+  ck_assert_int_eq(lengthof(keys), count);
+
+  release(list);
+
 } END_TEST
 
 int main(int argc, char **argv) {
@@ -35,6 +35,11 @@ START_TEST(date) {
 
   ck_assert($((Object *) null1, isEqual, (Object *) null2));
 
+  release(null1);
+  release(null2);
+
+  ck_assert_int_eq(1, ((Object *) $$(Null, null))->referenceCount);
+
 } END_TEST
 
 int main(int argc, char **argv) {
@@ -46,10 +46,47 @@ START_TEST(number) {
 
 } END_TEST
 
+START_TEST(numberWithValue) {
+
+  Number *zero = $$(Number, numberWithValue, 0);
+  ck_assert(zero == $$(Number, numberWithValue, 0.0));
+
+  Number *negativeZero = $$(Number, numberWithValue, -0.0);
+  ck_assert(zero != negativeZero);
+
+  Number *one = $$(Number, numberWithValue, 1);
+  ck_assert(one == $$(Number, numberWithValue, 1));
+  ck_assert_int_eq(1, $(one, intValue));
+
+  release(one);
+  release(one);
+  ck_assert_int_eq(1, ((Object *) one)->referenceCount);
+
+  Number *minusOne = $$(Number, numberWithValue, -1);
+  ck_assert(minusOne == $$(Number, numberWithValue, -1));
+  ck_assert_int_eq(-1, $(minusOne, intValue));
+
+  Number *min = $$(Number, numberWithValue, -256);
+  ck_assert(min == $$(Number, numberWithValue, -256));
+
+  Number *half = $$(Number, numberWithValue, 0.5);
+  ck_assert(half != NULL);
+  ck_assert_int_eq(0, ((Object *) half)->flags);
+
+  Number *large = $$(Number, numberWithValue, 1 << 20);
+  ck_assert_int_eq(1 << 20, $(large, intValue));
+
+  release(negativeZero);
+  release(half);
+  release(large);
+
+} END_TEST
+
 int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("Number");
   tcase_add_test(tcase, number);
+  tcase_add_test(tcase, numberWithValue);
 
   Suite *suite = suite_create("Number");
   suite_add_tcase(suite, tcase);
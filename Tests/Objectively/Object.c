@@ -22,6 +22,7 @@
  */
 
 #include <check.h>
+#include <dlfcn.h>
 
 #include "Objectively.h"
 
@@ -55,10 +56,41 @@ START_TEST(object) {
 
 } END_TEST
 
+START_TEST(_classForName) {
+
+  ck_assert_ptr_eq(_String(), classForName("String"));
+  ck_assert_ptr_eq(_Dictionary(), classForName("Dictionary"));
+
+  ck_assert_ptr_eq(NULL, classForName("NoSuchClass"));
+  ck_assert_ptr_eq(NULL, classForName("NoSuchClass"));
+
+  char name[32];
+  for (int i = 0; i < 2000; i++) {
+    snprintf(name, sizeof(name), "NoSuchClass%d", i);
+    ck_assert_ptr_eq(NULL, classForName(name));
+  }
+
+  ident handle = dlopen(NULL, RTLD_LAZY);
+  addClassImage(handle, (ident) _Object);
+
+  for (int i = 0; i < 2000; i++) {
+    snprintf(name, sizeof(name), "NoSuchClass%d", i);
+    ck_assert_ptr_eq(NULL, classForName(name));
+  }
+
+  removeClassImage(handle);
+  dlclose(handle);
+
+  ck_assert_ptr_eq(_Object(), classForName("Object"));
+  ck_assert_ptr_eq(_String(), classForName("String"));
+
+} END_TEST
+
 int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("Object");
   tcase_add_test(tcase, object);
+  tcase_add_test(tcase, _classForName);
 
   Suite *suite = suite_create("Object");
   suite_add_tcase(suite, tcase);
@@ -157,6 +157,27 @@ START_TEST(concurrent) {
   release(queue);
 } END_TEST
 
+START_TEST(sharedQueue) {
+
+  OperationQueue *queue = $$(OperationQueue, sharedQueue);
+  ck_assert(queue != NULL);
+  ck_assert_ptr_eq(queue, $$(OperationQueue, sharedQueue));
+
+  int flags[CONCURRENT_COUNT] = { 0 };
+
+  for (int i = 0; i < CONCURRENT_COUNT; i++) {
+    Operation *operation = $(queue, addOperationWithFunction, concurrent_func, &flags[i]);
+    release(operation);
+  }
+
+  $(queue, waitUntilAllOperationsAreFinished);
+
+  for (int i = 0; i < CONCURRENT_COUNT; i++) {
+    ck_assert_int_eq(1, flags[i]);
+  }
+
+} END_TEST
+
 int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("OperationQueue");
@@ -164,6 +185,7 @@ int main(int argc, char **argv) {
   tcase_add_test(tcase, suspendResume);
   tcase_add_test(tcase, cancelQueued);
   tcase_add_test(tcase, concurrent);
+  tcase_add_test(tcase, sharedQueue);
 
   Suite *suite = suite_create("OperationQueue");
   suite_add_tcase(suite, tcase);
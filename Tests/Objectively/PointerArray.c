@@ -45,6 +45,36 @@ START_TEST(add) {
 
 } END_TEST
 
+START_TEST(addPointers) {
+
+  int one = 1, two = 2, three = 3;
+  ident pointers[] = { &one, &two, &three };
+
+  PointerArray *array = $(alloc(PointerArray), init);
+
+  $(array, add, &three);
+  $(array, addPointers, lengthof(pointers), pointers);
+
+  ck_assert_int_eq(4, array->count);
+  ck_assert_ptr_eq(&three, array->elements[0]);
+  ck_assert_ptr_eq(&one, array->elements[1]);
+  ck_assert_ptr_eq(&three, array->elements[3]);
+
+  $(array, reserveCapacity, 100);
+  ck_assert_int_eq(100, array->capacity);
+
+  $(array, shrinkToFit);
+  ck_assert_int_eq(4, array->capacity);
+
+  $(array, removeAll);
+  $(array, shrinkToFit);
+  ck_assert_int_eq(0, array->capacity);
+  ck_assert_ptr_eq(NULL, array->elements);
+
+  release(array);
+
+} END_TEST
+
 static int destroyCount;
 static void *lastDestroyed;
 
@@ -208,6 +238,7 @@ int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("PointerArray");
   tcase_add_test(tcase, add);
+  tcase_add_test(tcase, addPointers);
   tcase_add_test(tcase, destroy);
   tcase_add_test(tcase, init);
   tcase_add_test(tcase, initWithDestroy);
@@ -173,11 +173,95 @@ START_TEST(set_mutation) {
 
 } END_TEST
 
+START_TEST(set_copy) {
+
+  Object *one = $(alloc(Object), init);
+  Object *two = $(alloc(Object), init);
+
+  Set *set = $(alloc(Set), initWithObjects, one, NULL);
+  Set *copy = (Set *) $((Object *) set, copy);
+
+  ck_assert_ptr_eq(set->elements, copy->elements);
+  ck_assert_int_eq(2, one->referenceCount);
+
+  $(copy, addObject, two);
+
+  ck_assert_ptr_ne(set->elements, copy->elements);
+  ck_assert(!$(set, containsObject, two));
+  ck_assert($(copy, containsObject, two));
+  ck_assert_int_eq(1, set->count);
+  ck_assert_int_eq(2, copy->count);
+  ck_assert_int_eq(3, one->referenceCount);
+
+  release(set);
+  release(copy);
+
+  ck_assert_int_eq(1, one->referenceCount);
+  ck_assert_int_eq(1, two->referenceCount);
+
+  release(one);
+  release(two);
+
+} END_TEST
+
+static bool odd(ident obj, ident data) {
+  return $((Number *) obj, intValue) & 1;
+}
+
+START_TEST(set_probing) {
+
+  Set *set = $$(Set, setWithCapacity, 3);
+
+  ck_assert_int_eq(4, set->capacity);
+
+  for (int i = 0; i < 4096; i++) {
+
+    Number *number = $$(Number, numberWithValue, i);
+
+    $(set, addObject, number);
+    $(set, addObject, number);
+
+    release(number);
+  }
+
+  ck_assert_int_eq(4096, set->count);
+  ck_assert_int_eq(0, set->capacity & (set->capacity - 1));
+
+  for (int i = 0; i < 4096; i += 4) {
+
+    Number *number = $$(Number, numberWithValue, i);
+
+    $(set, removeObject, number);
+
+    release(number);
+  }
+
+  ck_assert_int_eq(3072, set->count);
+
+  $(set, filter, odd, NULL);
+
+  ck_assert_int_eq(2048, set->count);
+
+  for (int i = 0; i < 4096; i++) {
+
+    Number *number = $$(Number, numberWithValue, i);
+
+    ck_assert_int_eq(i & 1, $(set, containsObject, number));
+
+    release(number);
+  }
+
+  release(set);
+
+} END_TEST
+
 
 int main(int argc, char **argv) {
 
   TCase *tcase = tcase_create("Set");
   tcase_add_test(tcase, set);
+  tcase_add_test(tcase, set_copy);
+  tcase_add_test(tcase, set_probing);
 
   tcase_add_test(tcase, set_mutation);
 
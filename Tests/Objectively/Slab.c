@@ -0,0 +1,165 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include <check.h>
+#include <stdlib.h>
+
+#include "Objectively.h"
+
+START_TEST(slab) {
+
+  Slab *slab = SlabCreate(24);
+  ck_assert(slab != NULL);
+
+  SlabStats stats = SlabGetStats(slab);
+  ck_assert_int_eq(0, stats.slabs);
+  ck_assert_int_eq(0, stats.bytes);
+
+  ident blocks[1024];
+  for (size_t i = 0; i < lengthof(blocks); i++) {
+    blocks[i] = SlabAlloc(slab);
+    ck_assert(blocks[i] != NULL);
+    ck_assert_int_eq(0, *(long *) blocks[i]);
+    ck_assert_int_eq(0, ((uintptr_t) blocks[i]) % 16);
+
+    *(long *) blocks[i] = (long) i + 1;
+  }
+
+  stats = SlabGetStats(slab);
+  ck_assert_int_gt(stats.slabs, 0);
+  ck_assert_int_ge(stats.bytes, lengthof(blocks) * 32);
+
+  for (size_t i = 0; i < lengthof(blocks); i++) {
+    ck_assert_int_eq((long) i + 1, *(long *) blocks[i]);
+    SlabFree(slab, blocks[i]);
+  }
+
+  for (size_t i = 0; i < lengthof(blocks); i++) {
+    blocks[i] = SlabAlloc(slab);
+    ck_assert_int_eq(0, *(long *) blocks[i]);
+  }
+
+  ck_assert_int_eq(stats.slabs, SlabGetStats(slab).slabs);
+
+  for (size_t i = 0; i < lengthof(blocks); i++) {
+    SlabFree(slab, blocks[i]);
+  }
+
+  SlabDestroy(slab);
+
+} END_TEST
+
+START_TEST(_class) {
+
+  ck_assert(_Object()->slab != NULL);
+  ck_assert(_String()->slab != NULL);
+
+  for (int i = 0; i < 1000; i++) {
+    String *string = $(alloc(String), initWithFormat, "%d", i);
+    ck_assert(string != NULL);
+
+    String *copy = (String *) $((Object *) string, copy);
+    ck_assert($((Object *) string, isEqual, (Object *) copy));
+
+    release(copy);
+    release(string);
+  }
+
+  const SlabStats stats = SlabGetStats(_String()->slab);
+  ck_assert_int_gt(stats.slabs, 0);
+
+  for (int i = 0; i < 1000; i++) {
+    release($(alloc(String), initWithFormat, "%d", i));
+  }
+
+  ck_assert_int_eq(stats.slabs, SlabGetStats(_String()->slab).slabs);
+
+} END_TEST
+
+static Lock *lock;
+
+static ident allocate(Thread *thread) {
+
+  Array *array = thread->data;
+
+  for (int i = 0; i < 10000; i++) {
+    Object *object = $(alloc(Object), init);
+    if (i & 1) {
+      synchronized(lock, $(array, addObject, object));
+    }
+    release(object);
+  }
+
+  return NULL;
+}
+
+START_TEST(threads) {
+
+  lock = $(alloc(Lock), init);
+
+  Array *array = $$(Array, array);
+  Array *threads = $$(Array, array);
+
+  for (int i = 0; i < 4; i++) {
+    Thread *thread = $(alloc(Thread), initWithFunction, allocate, array);
+    $(threads, addObject, thread);
+    release(thread);
+  }
+
+  for (size_t i = 0; i < threads->count; i++) {
+    $((Thread *) $(threads, objectAtIndex, i), start);
+  }
+
+  for (size_t i = 0; i < threads->count; i++) {
+    $((Thread *) $(threads, objectAtIndex, i), join, NULL);
+  }
+
+  ck_assert_int_eq(4 * 5000, array->count);
+
+  release(threads);
+  release(array);
+  release(lock);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+  setenv("OBJECTIVELY_ALLOCATOR", "slab", 1);
+
+  TCase *tcase = tcase_create("Slab");
+  tcase_add_test(tcase, slab);
+  tcase_add_test(tcase, _class);
+  tcase_add_test(tcase, threads);
+
+  Suite *suite = suite_create("Slab");
+  suite_add_tcase(suite, tcase);
+
+  SRunner *runner = srunner_create(suite);
+
+  srunner_run_all(runner, CK_VERBOSE);
+  int failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return failed;
+}
@@ -0,0 +1,176 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <check.h>
+
+#include "Objectively.h"
+
+START_TEST(slice) {
+
+  String *string = $(alloc(String), initWithCharacters, "Hello, World!");
+  Slice *slice = $(string, slice, (const Range) { 7, 5 });
+
+  ck_assert(slice);
+  ck_assert_ptr_eq(string, slice->parent);
+  ck_assert_int_eq(2, string->object.referenceCount);
+  ck_assert_ptr_eq(string->chars + 7, $(slice, bytes));
+  ck_assert_int_eq(5, slice->range.length);
+
+  String *world = $(slice, string);
+  ck_assert_str_eq("World", world->chars);
+
+  ck_assert($((Object *) slice, isEqual, (Object *) world));
+  ck_assert($((Object *) world, isEqual, (Object *) slice));
+  ck_assert_int_eq($((Object *) world, hash), $((Object *) slice, hash));
+
+  String *description = $((Object *) slice, description);
+  ck_assert_str_eq("World", description->chars);
+  release(description);
+
+  Slice *orl = $(slice, slice, (const Range) { 1, 3 });
+  ck_assert_ptr_eq(string, orl->parent);
+  ck_assert_int_eq(8, orl->range.location);
+  ck_assert(!$((Object *) orl, isEqual, (Object *) world));
+
+  Dictionary *dictionary = $(alloc(Dictionary), init);
+  $(dictionary, setObjectForKey, string, world);
+
+  ck_assert_ptr_eq(string, $(dictionary, objectForKey, slice));
+  ck_assert_ptr_eq(NULL, $(dictionary, objectForKey, orl));
+
+  $(string, appendCharacters, " This String is no longer stored inline.");
+  ck_assert($((Object *) slice, isEqual, (Object *) world));
+
+  release(dictionary);
+  release(orl);
+  release(world);
+  release(slice);
+
+  ck_assert_int_eq(1, string->object.referenceCount);
+  release(string);
+
+} END_TEST
+
+START_TEST(slice_data) {
+
+  const char *bytes = "\x01\x02\x03\x04";
+
+  Data *data = $$(Data, dataWithBytes, (const uint8_t *) bytes, 4);
+  Slice *slice = $(data, slice, (const Range) { 1, 2 });
+
+  Data *copy = $(slice, data);
+  ck_assert_int_eq(2, copy->length);
+  ck_assert_int_eq(0x02, copy->bytes[0]);
+
+  ck_assert($((Object *) slice, isEqual, (Object *) copy));
+  ck_assert($((Object *) copy, isEqual, (Object *) slice));
+  ck_assert_int_eq($((Object *) copy, hash), $((Object *) slice, hash));
+
+  String *string = $$(String, stringWithCharacters, "\x02\x03");
+  ck_assert(!$((Object *) slice, isEqual, (Object *) string));
+
+  release(string);
+  release(copy);
+  release(slice);
+  release(data);
+
+} END_TEST
+
+START_TEST(slicesSeparatedByCharacters) {
+
+  String *string = $$(String, stringWithCharacters, " a, b ,c");
+  Array *slices = $(string, slicesSeparatedByCharacters, ",");
+
+  ck_assert_int_eq(3, slices->count);
+
+  const char *expected[] = { "a", "b", "c" };
+
+  for (size_t i = 0; i < slices->count; i++) {
+    Slice *slice = $(slices, objectAtIndex, i);
+    ck_assert_ptr_eq(string, slice->parent);
+
+    Slice *trimmed = $(slice, trimmedSlice);
+    String *component = $(trimmed, string);
+
+    ck_assert_str_eq(expected[i], component->chars);
+
+    release(component);
+    release(trimmed);
+  }
+
+  Slice *trimmed = $(string, trimmedSlice);
+  ck_assert_int_eq(1, trimmed->range.location);
+  ck_assert_int_eq(7, trimmed->range.length);
+
+  release(trimmed);
+  release(slices);
+  release(string);
+
+} END_TEST
+
+START_TEST(readTokenSlice) {
+
+  StringReader *reader = $(alloc(StringReader), initWithCharacters, "one  two");
+
+  Unicode stop;
+
+  Slice *token = $(reader, readTokenSlice, L" ", &stop);
+  ck_assert_ptr_eq(reader->string, token->parent);
+  ck_assert_int_eq(0, token->range.location);
+  ck_assert_int_eq(3, token->range.length);
+  ck_assert_int_eq(' ', stop);
+  release(token);
+
+  token = $(reader, readTokenSlice, L" ", &stop);
+  ck_assert_int_eq(5, token->range.location);
+  ck_assert_int_eq(3, token->range.length);
+  ck_assert_int_eq(READER_EOF, stop);
+  release(token);
+
+  ck_assert_ptr_eq(NULL, $(reader, readTokenSlice, L" ", &stop));
+
+  release(reader);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+  TCase *tcase = tcase_create("Slice");
+  tcase_add_test(tcase, slice);
+  tcase_add_test(tcase, slice_data);
+  tcase_add_test(tcase, slicesSeparatedByCharacters);
+  tcase_add_test(tcase, readTokenSlice);
+
+  Suite *suite = suite_create("Slice");
+  suite_add_tcase(suite, tcase);
+
+  SRunner *runner = srunner_create(suite);
+
+  srunner_run_all(runner, CK_VERBOSE);
+  int failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return failed;
+}
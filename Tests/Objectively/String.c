@@ -22,6 +22,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <check.h>
 
@@ -221,6 +222,114 @@ START_TEST(string_initWithData) {
 
 } END_TEST
 
+START_TEST(string_case) {
+
+  String *string = str("The quick brown fox jumps over the lazy dog, déjà vu, Ångström");
+
+  String *upper = $(string, uppercaseString);
+  ck_assert_str_eq("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG, DÉJÀ VU, ÅNGSTRÖM", upper->chars);
+
+  String *lower = $(upper, lowercaseString);
+  ck_assert_str_eq("the quick brown fox jumps over the lazy dog, déjà vu, ångström", lower->chars);
+
+  release(lower);
+  release(upper);
+  release(string);
+
+  String *latin1 = str("ÿ µ ß × ÷");
+  String *latin1Upper = $(latin1, uppercaseString);
+  ck_assert_str_eq("Ÿ Μ ß × ÷", latin1Upper->chars);
+
+  release(latin1Upper);
+  release(latin1);
+
+  String *malformed = $$(String, stringWithMemory, strdup("a\xff" "b"), 3);
+  String *malformedUpper = $(malformed, uppercaseString);
+  ck_assert_str_eq("A\xff" "B", malformedUpper->chars);
+
+  release(malformedUpper);
+  release(malformed);
+
+} END_TEST
+
+START_TEST(string_getData) {
+
+  String *string = str("Aé€\U0001F600");
+
+  Data *utf16 = $(string, getData, STRING_ENCODING_UTF16);
+  ck_assert_int_eq(2 + 2 + 2 + 2 + 4, utf16->length);
+
+  const uint16_t *units = (const uint16_t *) utf16->bytes;
+  ck_assert_int_eq(0xfeff, units[0]);
+  ck_assert_int_eq(0x41, units[1]);
+  ck_assert_int_eq(0xe9, units[2]);
+  ck_assert_int_eq(0x20ac, units[3]);
+  ck_assert_int_eq(0xd83d, units[4]);
+  ck_assert_int_eq(0xde00, units[5]);
+
+  Data *utf32 = $(string, getData, STRING_ENCODING_UTF32);
+  ck_assert_int_eq(4 * 5, utf32->length);
+  ck_assert_int_eq(0x1f600, ((const uint32_t *) utf32->bytes)[4]);
+
+  Data *wchar = $(string, getData, STRING_ENCODING_WCHAR);
+  ck_assert_int_eq(0x41, ((const wchar_t *) wchar->bytes)[0]);
+
+  const StringEncoding encodings[] = {
+    STRING_ENCODING_UTF8,
+    STRING_ENCODING_UTF16,
+    STRING_ENCODING_UTF32,
+    STRING_ENCODING_WCHAR
+  };
+
+  for (size_t i = 0; i < lengthof(encodings); i++) {
+    Data *data = $(string, getData, encodings[i]);
+    String *decoded = $$(String, stringWithData, data, encodings[i]);
+    ck_assert_str_eq(string->chars, decoded->chars);
+    release(decoded);
+    release(data);
+  }
+
+  const uint8_t swapped[] = { 0xfe, 0xff, 0x00, 0x41, 0x00, 0xe9 };
+  String *bigEndian = $$(String, stringWithBytes, swapped, sizeof(swapped), STRING_ENCODING_UTF16);
+  ck_assert_str_eq("Aé", bigEndian->chars);
+
+  String *latin1 = str("déjà");
+
+  Data *data = $(latin1, getData, STRING_ENCODING_LATIN1);
+  ck_assert_int_eq(4, data->length);
+  ck_assert_int_eq(0xe9, data->bytes[1]);
+
+  String *decoded = $$(String, stringWithData, data, STRING_ENCODING_LATIN1);
+  ck_assert_str_eq(latin1->chars, decoded->chars);
+  release(decoded);
+  release(data);
+
+  String *latin2 = str("Dvořák");
+
+  data = $(latin2, getData, STRING_ENCODING_LATIN2);
+  ck_assert_int_eq(6, data->length);
+
+  decoded = $$(String, stringWithData, data, STRING_ENCODING_LATIN2);
+  ck_assert_str_eq(latin2->chars, decoded->chars);
+  release(decoded);
+  release(data);
+
+  String *empty = $$(String, string);
+  data = $(empty, getData, STRING_ENCODING_UTF16);
+  ck_assert_int_eq(0, data->length);
+  release(data);
+
+  release(empty);
+  release(latin2);
+  release(latin1);
+  release(bigEndian);
+  release(wchar);
+  release(utf32);
+  release(utf16);
+  release(string);
+
+} END_TEST
+
 START_TEST(string_initWithContentsOfFile) {
 
   const char *path = "/tmp/Objectively_String.test";
@@ -239,6 +348,266 @@ START_TEST(string_initWithContentsOfFile) {
 
 } END_TEST
 
+START_TEST(string_search) {
+
+  String *string = str("abababababababababababababababababababc, and then some abc");
+
+  Range match = $(string, rangeOfCharacters, "abc", (Range) { 0, string->length });
+  ck_assert_int_eq(36, match.location);
+  ck_assert_int_eq(3, match.length);
+
+  match = $(string, rangeOfCharacters, "abc", (Range) { 37, string->length - 37 });
+  ck_assert_int_eq(55, match.location);
+
+  match = $(string, rangeOfCharacters, "abc", (Range) { 0, 38 });
+  ck_assert_int_eq(-1, match.location);
+
+  match = $(string, rangeOfCharacters, "some", (Range) { 0, string->length });
+  ck_assert_int_eq(50, match.location);
+
+  match = $(string, rangeOfCharacters, "x", (Range) { 0, string->length });
+  ck_assert_int_eq(-1, match.location);
+
+  release(string);
+
+  srand(1);
+
+  char haystack[512], needle[8];
+  for (int i = 0; i < 1000; i++) {
+
+    const size_t length = rand() % (sizeof(haystack) - 1) + 1;
+    for (size_t j = 0; j < length; j++) {
+      haystack[j] = 'a' + rand() % 3;
+    }
+    haystack[length] = '\0';
+
+    const size_t len = rand() % (sizeof(needle) - 1) + 1;
+    for (size_t j = 0; j < len; j++) {
+      needle[j] = 'a' + rand() % 3;
+    }
+    needle[len] = '\0';
+
+    string = $$(String, stringWithCharacters, haystack);
+
+    const char *expected = strstr(haystack, needle);
+    match = $(string, rangeOfCharacters, needle, (Range) { 0, length });
+    ck_assert_int_eq(expected ? expected - haystack : -1, match.location);
+
+    release(string);
+  }
+
+} END_TEST
+
+START_TEST(string_replaceOccurrences) {
+
+  String *string = str("{{name}} says hello to {{name}}, and {{name}} again");
+
+  $(string, replaceOccurrencesOfCharacters, "{{name}}", "Jay");
+  ck_assert_str_eq("Jay says hello to Jay, and Jay again", string->chars);
+
+  $(string, replaceOccurrencesOfCharacters, "Jay", "Objectively");
+  ck_assert_str_eq("Objectively says hello to Objectively, and Objectively again", string->chars);
+
+  $(string, replaceOccurrencesOfCharacters, "a", "A");
+  ck_assert_str_eq("Objectively sAys hello to Objectively, And Objectively AgAin", string->chars);
+
+  $(string, replaceOccurrencesOfCharactersInRange, "Objectively", (Range) { 0, 37 }, "it");
+  ck_assert_str_eq("it sAys hello to it, And Objectively AgAin", string->chars);
+
+  $(string, replaceOccurrencesOfCharacters, "it", "");
+  ck_assert_str_eq(" sAys hello to , And Objectively AgAin", string->chars);
+
+  $(string, replaceOccurrencesOfCharacters, "missing", "nothing");
+  ck_assert_str_eq(" sAys hello to , And Objectively AgAin", string->chars);
+
+  $(string, setCharacters, "aaaa");
+  $(string, replaceOccurrencesOfCharacters, "aa", "b");
+  ck_assert_str_eq("bb", string->chars);
+
+  ck_assert_int_eq($((Object *) string, hash), $((Object *) strlit("bb"), hash));
+
+  release(string);
+
+} END_TEST
+
+START_TEST(string_capacity) {
+
+  String *string = $(alloc(String), initWithCharacters, "short");
+
+  ck_assert_ptr_eq(string->storage, string->chars);
+  ck_assert_int_eq(STRING_INLINE_CAPACITY, string->capacity);
+
+  for (int i = 0; i < 100; i++) {
+    $(string, appendCharacters, "0123456789");
+  }
+
+  ck_assert_ptr_ne(string->storage, string->chars);
+  ck_assert_int_eq(1005, string->length);
+  ck_assert_int_lt(string->capacity, 2 * (string->length + 1));
+
+  $(string, shrinkToFit);
+
+  ck_assert_int_eq(string->length + 1, string->capacity);
+  ck_assert(strncmp("short0123456789", string->chars, 15) == 0);
+
+  $(string, setLength, 5);
+  $(string, shrinkToFit);
+
+  ck_assert_ptr_eq(string->storage, string->chars);
+  ck_assert_str_eq("short", string->chars);
+
+  $(string, replaceCharactersInRange, (Range) { 0, 5 }, "longer than the inline storage");
+
+  ck_assert_ptr_ne(string->storage, string->chars);
+  ck_assert_str_eq("longer than the inline storage", string->chars);
+
+  release(string);
+
+  String *literal = strlit("hi");
+  const char *chars = literal->chars;
+
+  $(literal, shrinkToFit);
+
+  ck_assert_ptr_eq(chars, literal->chars);
+  ck_assert_str_eq("hi", literal->chars);
+
+} END_TEST
+
+START_TEST(string_hash) {
+
+  String *string = $(alloc(String), initWithCharacters, "hello");
+  String *other = $(alloc(String), initWithCharacters, "hello world");
+
+  const int hash = $((Object *) string, hash);
+
+  ck_assert_int_eq(hash, string->hash);
+  ck_assert_int_eq(hash, $((Object *) string, hash));
+
+  $(string, appendCharacters, " world");
+
+  ck_assert_int_eq(0, string->hash);
+  ck_assert_int_eq($((Object *) other, hash), $((Object *) string, hash));
+
+  $(string, setLength, 5);
+
+  ck_assert_int_eq(hash, $((Object *) string, hash));
+
+  $(string, replaceCharactersInRange, (Range) { 0, 1 }, "j");
+
+  ck_assert_int_ne(hash, $((Object *) string, hash));
+
+  release(string);
+  release(other);
+
+} END_TEST
+
+START_TEST(string_intern) {
+
+  String *a = $$(String, internedStringWithCharacters, "key", 3);
+  String *b = $$(String, internedStringWithCharacters, "keys", 3);
+
+  ck_assert_ptr_eq(a, b);
+  ck_assert_str_eq("key", a->chars);
+
+  String *string = $(alloc(String), initWithCharacters, "key");
+
+  ck_assert_ptr_ne(a, string);
+  ck_assert_ptr_eq(a, $(string, internedString));
+  ck_assert_ptr_eq(a, $(a, internedString));
+
+  ck_assert($((Object *) a, isEqual, (Object *) string));
+  ck_assert($((Object *) string, isEqual, (Object *) a));
+  ck_assert_int_eq($((Object *) string, hash), $((Object *) a, hash));
+
+  String *other = $$(String, internedStringWithCharacters, "kez", 3);
+
+  ck_assert_ptr_ne(a, other);
+  ck_assert(!$((Object *) a, isEqual, (Object *) other));
+
+  Dictionary *dictionary = $(alloc(Dictionary), init);
+  $(dictionary, setObjectForKey, other, a);
+
+  ck_assert_ptr_eq(other, $(dictionary, objectForKey, a));
+  ck_assert_ptr_eq(other, $(dictionary, objectForKey, string));
+
+  release(dictionary);
+  release(string);
+
+  release(a);
+  release(b);
+  release(other);
+
+  ck_assert_ptr_eq(a, $$(String, internedStringWithCharacters, "key", 3));
+
+  const char *json = "[{\"key\": 1}, {\"k\\u0065y\": 2}]";
+
+  Data *data = $$(Data, dataWithConstMemory, (ident) json, strlen(json));
+  JSONContext *ctx = $(alloc(JSONContext), init);
+
+  Array *array = $(ctx, objectFromData, data, 0);
+  ck_assert_int_eq(2, array->count);
+
+  for (size_t i = 0; i < array->count; i++) {
+    Array *keys = $((Dictionary *) $(array, objectAtIndex, i), allKeys);
+    ck_assert_ptr_eq(a, $(keys, objectAtIndex, 0));
+    release(keys);
+  }
+
+  release(array);
+  release(ctx);
+  release(data);
+
+} END_TEST
+
+
+/**
+ * @return The `strlit` for "literal", from a call site of its own.
+ */
+static String *literal(void) {
+  return strlit("literal");
+}
+
+START_TEST(string_literal) {
+
+  String *a = strlit("literal");
+
+  ck_assert_str_eq("literal", a->chars);
+  ck_assert_int_eq(7, a->length);
+  ck_assert(a->interned);
+  ck_assert(a->object.flags & OBJECT_IMMORTAL);
+  ck_assert(a->object.flags & OBJECT_STATIC);
+
+  ck_assert_ptr_eq(a, literal());
+  ck_assert_ptr_eq(a, $$(String, internedStringWithCharacters, "literal", 7));
+
+  String *string = $(alloc(String), initWithCharacters, "literal");
+
+  ck_assert($((Object *) a, isEqual, (Object *) string));
+  ck_assert_int_eq($((Object *) string, hash), $((Object *) a, hash));
+
+  Dictionary *dictionary = $(alloc(Dictionary), init);
+  $(dictionary, setObjectForKey, string, a);
+
+  ck_assert_ptr_eq(string, $(dictionary, objectForKey, string));
+  ck_assert_ptr_eq(string, $(dictionary, objectForKey, strlit("literal")));
+
+  release(retain(a));
+  ck_assert_int_eq(1, a->object.referenceCount);
+
+  String *copy = (String *) $((Object *) a, copy);
+  $(copy, appendCharacters, "!");
+  ck_assert_str_eq("literal!", copy->chars);
+
+  release(copy);
+  release(dictionary);
+  release(string);
+
+  String *interned = $$(String, internedStringWithCharacters, "interned first", 14);
+  ck_assert_ptr_eq(interned, strlit("interned first"));
+  ck_assert((strlit("interned first")->object.flags & OBJECT_STATIC) == 0);
+
+} END_TEST
+
 
 int main(int argc, char **argv) {
 
@@ -247,9 +616,17 @@ int main(int argc, char **argv) {
   tcase_add_test(tcase, _strtrim);
 
   tcase_add_test(tcase, string_mutation);
+  tcase_add_test(tcase, string_search);
+  tcase_add_test(tcase, string_replaceOccurrences);
+  tcase_add_test(tcase, string_capacity);
+  tcase_add_test(tcase, string_hash);
+  tcase_add_test(tcase, string_intern);
+  tcase_add_test(tcase, string_literal);
   tcase_add_test(tcase, string_appendBytes);
   tcase_add_test(tcase, string_initWithBytes);
   tcase_add_test(tcase, string_initWithData);
+  tcase_add_test(tcase, string_case);
+  tcase_add_test(tcase, string_getData);
   tcase_add_test(tcase, string_initWithContentsOfFile);
 
   Suite *suite = suite_create("String");
@@ -0,0 +1,150 @@
+/*
+ * Objectively: Ultra-lightweight object oriented framework for GNU C.
+ * Copyright (C) 2014 Jay Dolan <jay@jaydolan.com>
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ * claim that you wrote the original software. If you use this software
+ * in a product, an acknowledgment in the product documentation would be
+ * appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ * misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include <check.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "Objectively.h"
+
+START_TEST(stringBuilder) {
+
+  StringBuilder *builder = $(alloc(StringBuilder), init);
+  ck_assert(builder);
+  ck_assert_int_eq(0, builder->length);
+
+  String *empty = $(builder, string);
+  ck_assert_str_eq("", empty->chars);
+  release(empty);
+
+  $(builder, appendCharacters, "Hello");
+  $(builder, appendBytes, (const uint8_t *) ", ", 2);
+
+  String *world = $$(String, stringWithCharacters, "World");
+  $(builder, appendString, world);
+  release(world);
+
+  $(builder, appendFormat, "%c %d", '!', 42);
+
+  ck_assert_int_eq(16, builder->length);
+
+  String *string = $(builder, string);
+  ck_assert_str_eq("Hello, World! 42", string->chars);
+  ck_assert_int_eq(16, string->length);
+  release(string);
+
+  Data *data = $(builder, data);
+  ck_assert_int_eq(16, data->length);
+  ck_assert(memcmp("Hello, World! 42", data->bytes, 16) == 0);
+  release(data);
+
+  release(builder);
+
+} END_TEST
+
+START_TEST(stringBuilder_chunks) {
+
+  StringBuilder *builder = $(alloc(StringBuilder), init);
+  String *expected = $(alloc(String), init);
+
+  for (int i = 0; i < 10000; i++) {
+    $(builder, appendFormat, "%d,", i);
+    $(expected, appendFormat, "%d,", i);
+  }
+
+  char large[100000];
+  memset(large, 'x', sizeof(large) - 1);
+  large[sizeof(large) - 1] = '\0';
+
+  $(builder, appendCharacters, large);
+  $(expected, appendCharacters, large);
+
+  $(builder, appendFormat, "%s", large);
+  $(expected, appendFormat, "%s", large);
+
+  ck_assert_int_eq(expected->length, builder->length);
+
+  String *string = $(builder, string);
+  ck_assert_str_eq(expected->chars, string->chars);
+  release(string);
+
+  FILE *file = tmpfile();
+  ck_assert(file);
+
+  ck_assert($(builder, writeToFileDescriptor, fileno(file)));
+  ck_assert_int_eq(expected->length, ftell(file));
+
+  rewind(file);
+
+  char *chars = calloc(expected->length + 1, 1);
+  ck_assert_int_eq(expected->length, fread(chars, 1, expected->length, file));
+  ck_assert_str_eq(expected->chars, chars);
+
+  free(chars);
+  fclose(file);
+
+  release(expected);
+  release(builder);
+
+} END_TEST
+
+START_TEST(stringBuilder_description) {
+
+  Array *array = $$(Array, arrayWithObjects, str("a"), str("b"), NULL);
+
+  String *desc = $((Object *) array, description);
+  ck_assert_str_eq("[a, b]", desc->chars);
+  release(desc);
+
+  String *joined = $(array, componentsJoinedByCharacters, "-");
+  ck_assert_str_eq("a-b", joined->chars);
+  release(joined);
+
+  for (size_t i = 0; i < array->count; i++) {
+    release($(array, objectAtIndex, i));
+  }
+
+  release(array);
+
+} END_TEST
+
+int main(int argc, char **argv) {
+
+  TCase *tcase = tcase_create("StringBuilder");
+  tcase_add_test(tcase, stringBuilder);
+  tcase_add_test(tcase, stringBuilder_chunks);
+  tcase_add_test(tcase, stringBuilder_description);
+
+  Suite *suite = suite_create("StringBuilder");
+  suite_add_tcase(suite, tcase);
+
+  SRunner *runner = srunner_create(suite);
+
+  srunner_run_all(runner, CK_VERBOSE);
+  int failed = srunner_ntests_failed(runner);
+
+  srunner_free(runner);
+
+  return failed;
+}
@@ -122,6 +122,19 @@ START_TEST(filter) {
   ck_assert_int_eq(1, vector->count);
   ck_assert_int_eq(2, VectorElement(vector, Foo, 0)->bar);
 
+  $(vector, add, &one);
+  $(vector, add, &one);
+  $(vector, add, &two);
+  $(vector, add, &three);
+  $(vector, add, &two);
+
+  $(vector, filter, predicate, (ident) 2);
+
+  ck_assert_int_eq(3, vector->count);
+  for (size_t i = 0; i < vector->count; i++) {
+    ck_assert_int_eq(2, VectorElement(vector, Foo, i)->bar);
+  }
+
   release(vector);
 
 } END_TEST
@@ -201,6 +214,40 @@ START_TEST(insert) {
 
 } END_TEST
 
+START_TEST(insertElements) {
+
+  Vector *vector = $(alloc(Vector), initWithSize, sizeof(Foo));
+
+  const Foo foos[] = { { 1 }, { 2 }, { 3 }, { 4 } };
+
+  $(vector, addElements, 2, (ident) foos);
+  $(vector, insertElements, 2, (ident) (foos + 2), 1);
+
+  ck_assert_int_eq(4, vector->count);
+
+  ck_assert_int_eq(1, VectorElement(vector, Foo, 0)->bar);
+  ck_assert_int_eq(3, VectorElement(vector, Foo, 1)->bar);
+  ck_assert_int_eq(4, VectorElement(vector, Foo, 2)->bar);
+  ck_assert_int_eq(2, VectorElement(vector, Foo, 3)->bar);
+
+  $(vector, reserveCapacity, 100);
+  ck_assert_int_eq(100, vector->capacity);
+
+  $(vector, shrinkToFit);
+  ck_assert_int_eq(4, vector->capacity);
+
+  for (int i = 0; i < 1000; i++) {
+    $(vector, add, &(Foo) { i });
+  }
+
+  ck_assert_int_eq(1004, vector->count);
+  ck_assert_int_lt(vector->capacity, 2 * vector->count);
+  ck_assert_int_eq(999, VectorElement(vector, Foo, 1003)->bar);
+
+  release(vector);
+
+} END_TEST
+
 static ident reducer(const ident obj, ident accumulator, ident data) {
   return accumulator + ((Foo *) obj)->bar;
 }
@@ -315,6 +362,83 @@ START_TEST(sort) {
 
 } END_TEST
 
+static Order byBar(const ident a, const ident b) {
+  return ((Foo *) a)->bar / 10 - ((Foo *) b)->bar / 10;
+}
+
+START_TEST(stableSort) {
+
+  Vector *vector = $(alloc(Vector), initWithSize, sizeof(Foo));
+
+  for (int i = 0; i < 1000; i++) {
+    $(vector, add, &(Foo) { .bar = ((i * 7919) % 100) * 10 + i % 10 });
+  }
+
+  Vector *expected = $(alloc(Vector), initWithSize, sizeof(Foo));
+
+  for (int key = 0; key < 100; key++) {
+    for (size_t i = 0; i < vector->count; i++) {
+      if (VectorElement(vector, Foo, i)->bar / 10 == key) {
+        $(expected, add, VectorElement(vector, Foo, i));
+      }
+    }
+  }
+
+  $(vector, stableSort, byBar);
+
+  ck_assert_int_eq(expected->count, vector->count);
+  for (size_t i = 0; i < vector->count; i++) {
+    ck_assert_int_eq(VectorElement(expected, Foo, i)->bar, VectorElement(vector, Foo, i)->bar);
+  }
+
+  release(expected);
+  release(vector);
+
+} END_TEST
+
+static ident tripled(const ident element, ident data) {
+
+  static __thread Foo foo;
+
+  foo.bar = ((Foo *) element)->bar * 3;
+  return &foo;
+}
+
+static ident sum(const ident element, ident accumulator, ident data) {
+  return (ident) ((intptr_t) accumulator + ((Foo *) element)->bar);
+}
+
+static ident combine(const ident partial, ident accumulator, ident data) {
+  return (ident) ((intptr_t) accumulator + (intptr_t) partial);
+}
+
+START_TEST(parallel) {
+
+  Vector *vector = $(alloc(Vector), initWithSize, sizeof(Foo));
+
+  intptr_t total = 0;
+  for (int i = 0; i < 100000; i++) {
+    $(vector, add, &(Foo) { .bar = i });
+    total += i;
+  }
+
+  OperationQueue *queue = $(alloc(OperationQueue), initWithMaxConcurrentOperations, 4);
+
+  Vector *mapped = $(vector, parallelMappedVector, tripled, NULL, queue);
+  ck_assert_int_eq(vector->count, mapped->count);
+  for (size_t i = 0; i < mapped->count; i++) {
+    ck_assert_int_eq(i * 3, VectorElement(mapped, Foo, i)->bar);
+  }
+
+  ck_assert_int_eq(total, (intptr_t) $(vector, parallelReduce, sum, combine, (ident) 0, NULL, queue));
+  ck_assert_int_eq(total, (intptr_t) $(vector, parallelReduce, sum, combine, (ident) 0, NULL, NULL));
+
+  release(mapped);
+  release(queue);
+  release(vector);
+
+} END_TEST
+
 static ident functor(const ident element, ident data) {
   static Foo result;
   result.bar = ((Foo *) element)->bar * 2;
@@ -354,12 +478,15 @@ int main(int argc, char **argv) {
   tcase_add_test(tcase, initWithElements);
   tcase_add_test(tcase, initWithSize);
   tcase_add_test(tcase, insert);
+  tcase_add_test(tcase, insertElements);
   tcase_add_test(tcase, mappedVector);
   tcase_add_test(tcase, reduce);
   tcase_add_test(tcase, removeAll);
   tcase_add_test(tcase, removeAt);
   tcase_add_test(tcase, resize);
+  tcase_add_test(tcase, parallel);
   tcase_add_test(tcase, sort);
+  tcase_add_test(tcase, stableSort);
 
   Suite *suite = suite_create("Vector");
   suite_add_tcase(suite, tcase);